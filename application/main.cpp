@@ -147,6 +147,12 @@ int main(int argc, char *argv[])
     NoColorArgument noColorArg;
     ConfigValueArgument timeSpanFormatArg("time-span-format", '\0', "specifies the output format for time spans", { "measures/colons/seconds" });
     timeSpanFormatArg.setPreDefinedCompletionValues("measures colons seconds");
+    // I/O scheduling options for batch operations
+    ConfigValueArgument ioPriorityArg("io-priority", '\0', "specifies the I/O scheduling class of the process (only supported under Linux)",
+        { "idle/normal/realtime" });
+    ioPriorityArg.setPreDefinedCompletionValues("idle normal realtime");
+    ConfigValueArgument ioRateLimitArg(
+        "io-rate-limit", '\0', "limits the throughput when rewriting files to not starve other processes accessing the disk", { "MiB/s" });
     // verbose option
     ConfigValueArgument verboseArg("verbose", 'v', "be verbose");
     // input/output file/files
@@ -157,6 +163,9 @@ int main(int argc, char *argv[])
     ConfigValueArgument filesArg("files", 'f', "specifies the path of the file(s) to be opened", { "path 1", "path 2" });
     filesArg.setRequiredValueCount(Argument::varValueCount);
     ConfigValueArgument outputFileArg("output-file", 'o', "specifies the path of the output file", { "path" });
+    // number of parallel jobs for batch operations
+    ConfigValueArgument jobsArg("jobs", '\0', "specifies the number of files to process in parallel (defaults to the number of CPU threads)",
+        { "number" });
     // print field names
     OperationArgument printFieldNamesArg("print-field-names", '\0', "lists available field names, track attribute names and modifier");
     printFieldNamesArg.setCallback(Cli::printFieldNames);
@@ -172,9 +181,12 @@ int main(int argc, char *argv[])
     OperationArgument displayTagInfoArg("get", 'g', "displays the values of all specified tag fields (displays all fields if none specified)",
         PROJECT_NAME " get title album artist -f /some/dir/*.m4a");
     ConfigValueArgument showUnsupportedArg("show-unsupported", 'u', "shows unsupported fields (has only effect when no field names specified)");
-    displayTagInfoArg.setCallback(
-        std::bind(Cli::displayTagInfo, std::cref(fieldsArg), std::cref(showUnsupportedArg), std::cref(filesArg), std::cref(verboseArg)));
-    displayTagInfoArg.setSubArguments({ &fieldsArg, &showUnsupportedArg, &filesArg, &verboseArg });
+    ConfigValueArgument formatArg("format", '\0', "specifies the output format; tsv and csv print one row per file and one column per field",
+        { "human/tsv/csv" });
+    formatArg.setPreDefinedCompletionValues("human tsv csv");
+    displayTagInfoArg.setCallback(std::bind(Cli::displayTagInfo, std::cref(fieldsArg), std::cref(showUnsupportedArg), std::cref(filesArg),
+        std::cref(verboseArg), std::cref(formatArg)));
+    displayTagInfoArg.setSubArguments({ &fieldsArg, &showUnsupportedArg, &filesArg, &verboseArg, &formatArg });
     // set tag info
     Cli::SetTagInfoArgs setTagInfoArgs(filesArg, verboseArg);
     // extract cover
@@ -189,16 +201,91 @@ int main(int argc, char *argv[])
     extractFieldArg.setCallback(std::bind(
         Cli::extractField, std::cref(fieldArg), std::cref(attachmentArg), std::cref(fileArg), std::cref(outputFileArg), std::cref(verboseArg)));
     // export to JSON
-    ConfigValueArgument prettyArg("pretty", '\0', "prints with indentation and spacing");
+    ConfigValueArgument prettyArg("pretty", '\0', "prints with indentation and spacing (only supported by the format json)");
+    ConfigValueArgument sinceArg("since", '\0',
+        "exports only files which have been added or changed since the specified snapshot and lists removed files; the snapshot is updated "
+        "(or created if not existing yet)",
+        { "snapshot path" });
+    ConfigValueArgument exportFormatArg("format", '\0',
+        "specifies the encoding; cbor is a compact binary encoding of the same structure containing binary data (eg. covers) unencoded",
+        { "json/cbor" });
+    exportFormatArg.setPreDefinedCompletionValues("json cbor");
     OperationArgument exportArg("export", 'j', "exports the tag information for the specified files to JSON");
-    exportArg.setSubArguments({ &filesArg, &prettyArg });
-    exportArg.setCallback(std::bind(Cli::exportToJson, _1, std::cref(filesArg), std::cref(prettyArg)));
+    exportArg.setSubArguments({ &filesArg, &prettyArg, &sinceArg, &exportFormatArg });
+    exportArg.setCallback(
+        std::bind(Cli::exportToJson, _1, std::cref(filesArg), std::cref(prettyArg), std::cref(sinceArg), std::cref(exportFormatArg)));
+    // import from JSON
+    ConfigValueArgument inputFileArg("input-file", 'i', "specifies the path of the input file", { "path" });
+    inputFileArg.setRequired(true);
+    OperationArgument importArg("import", '\0',
+        "applies the tag information of a JSON document created via export to the specified files (or to the files contained by an export "
+        "created via --since)");
+    importArg.setSubArguments({ &inputFileArg, &filesArg, &jobsArg, &verboseArg });
+    importArg.setExample(PROJECT_NAME " import --input-file tags.json -f /some/dir/*.m4a");
+    importArg.setCallback(
+        std::bind(Cli::importFromJson, _1, std::cref(inputFileArg), std::cref(filesArg), std::cref(jobsArg), std::cref(verboseArg)));
     // file info
     ConfigValueArgument validateArg(
         "validate", 'c', "validates the file integrity as accurately as possible; the structure of the file will be parsed completely");
-    OperationArgument genInfoArg("html-info", '\0', "generates technical information about the specified file as HTML document");
-    genInfoArg.setSubArguments({ &fileArg, &validateArg, &outputFileArg });
-    genInfoArg.setCallback(std::bind(Cli::generateFileInfo, _1, std::cref(fileArg), std::cref(outputFileArg), std::cref(validateArg)));
+    ConfigValueArgument infoFilesArg("file", 'f',
+        "specifies the path of the file to be analyzed; multiple files and directories (which are scanned recursively) can be specified "
+        "in combination with --output-dir",
+        { "path 1", "path 2" });
+    infoFilesArg.setRequiredValueCount(Argument::varValueCount);
+    infoFilesArg.setRequired(true);
+    ConfigValueArgument outputDirArg("output-dir", '\0',
+        "specifies the directory to write one document per file, an index and the style sheet/script shared by the documents to", { "path" });
+    OperationArgument genInfoArg("html-info", '\0', "generates technical information about the specified file(s) as HTML document(s)");
+    genInfoArg.setSubArguments({ &infoFilesArg, &validateArg, &outputFileArg, &outputDirArg, &jobsArg });
+    genInfoArg.setExample(PROJECT_NAME " html-info -f file.mkv -o info.xhtml\n" PROJECT_NAME " html-info -f /some/dir --output-dir /some/report");
+    genInfoArg.setCallback(std::bind(Cli::generateFileInfo, _1, std::cref(infoFilesArg), std::cref(outputFileArg), std::cref(outputDirArg),
+        std::cref(validateArg), std::cref(jobsArg)));
+    // integrity validation
+    ConfigValueArgument validationFormatArg("format", '\0',
+        "specifies the format of the report; tsv, csv and json print one record per file (the summary goes to stderr)", { "human/tsv/csv/json" });
+    validationFormatArg.setPreDefinedCompletionValues("human tsv csv json");
+    OperationArgument validateOperationArg("validate", '\0',
+        "parses the specified files completely to check their integrity; lists files with warnings or critical issues (all files with --verbose) "
+        "and exits with status 1 if critical issues have been found");
+    validateOperationArg.setSubArguments({ &filesArg, &jobsArg, &validationFormatArg, &verboseArg });
+    validateOperationArg.setExample(PROJECT_NAME " validate --format tsv -f /some/dir/*.mkv > report.tsv");
+    validateOperationArg.setCallback(
+        std::bind(Cli::validateFiles, _1, std::cref(filesArg), std::cref(jobsArg), std::cref(validationFormatArg), std::cref(verboseArg)));
+    // cover normalization
+    ConfigValueArgument maxCoverSizeArg(
+        "max-size", '\0', "specifies the maximum width/height of covers; bigger covers are downsized (defaults to 1000)", { "pixel" });
+    ConfigValueArgument coverFormatArg("format", '\0', "specifies the format to re-encode covers with (defaults to jpeg)", { "jpeg/png" });
+    coverFormatArg.setPreDefinedCompletionValues("jpeg png");
+    ConfigValueArgument coverQualityArg("quality", '\0', "specifies the quality to re-encode covers with (defaults to 85)", { "0-100" });
+    OperationArgument normalizeCoversArg("normalize-covers", '\0',
+        "downsizes covers exceeding the maximum size and re-encodes covers not stored as JPEG/PNG; covers are only replaced if smaller");
+    normalizeCoversArg.setSubArguments({ &filesArg, &maxCoverSizeArg, &coverFormatArg, &coverQualityArg, &jobsArg, &verboseArg });
+    normalizeCoversArg.setExample(PROJECT_NAME " normalize-covers --max-size 800 --quality 80 -f /some/dir/*.mp3");
+    normalizeCoversArg.setCallback(std::bind(Cli::normalizeCovers, _1, std::cref(filesArg), std::cref(maxCoverSizeArg), std::cref(coverFormatArg),
+        std::cref(coverQualityArg), std::cref(jobsArg), std::cref(verboseArg)));
+    // renaming via template or script
+    ConfigValueArgument templateArg("template", 't',
+        "specifies the template for the new path, eg. \"%albumartist|artist%/%album%/%track:02% - %title%\"; the extension is kept; with "
+        "--files the path is relative to the target directory; with --dir a path without \"/\" renames the file within its directory and "
+        "other paths are relative to the specified directory",
+        { "template" });
+    ConfigValueArgument scriptArg(
+        "script", '\0', "specifies the script of the renaming utility to generate the new names (requires --dir)", { "path" });
+    ConfigValueArgument renameDirArg("dir", '\0',
+        "specifies the directory containing the files to be renamed like the renaming utility of the GUI does (instead of --files)", { "path" });
+    ConfigValueArgument recursiveArg("recursive", 'r', "includes subdirectories (only in combination with --dir)");
+    ConfigValueArgument targetDirArg(
+        "target-dir", '\0', "specifies the directory the generated paths are relative to (defaults to the directory of each file)", { "path" });
+    ConfigValueArgument dryRunArg("dry-run", '\0', "only prints the new paths without renaming any files");
+    OperationArgument renameArg("rename", '\0',
+        "renames/moves the specified files according to a template or script using the values of their tags and prints the changes; existing "
+        "files are never overwritten");
+    renameArg.setSubArguments(
+        { &filesArg, &renameDirArg, &templateArg, &scriptArg, &targetDirArg, &recursiveArg, &dryRunArg, &jobsArg, &verboseArg });
+    renameArg.setExample(PROJECT_NAME " rename --template '%artist%/%album%/%track:02% - %title%' --target-dir /music --dry-run -f *.mp3\n"
+                                      PROJECT_NAME " rename --script rename.js --dir /music --recursive");
+    renameArg.setCallback(std::bind(Cli::renameFiles, _1, std::cref(filesArg), std::cref(renameDirArg), std::cref(templateArg), std::cref(scriptArg),
+        std::cref(targetDirArg), std::cref(recursiveArg), std::cref(dryRunArg), std::cref(jobsArg), std::cref(verboseArg)));
     // renaming utility
     ConfigValueArgument renamingUtilityArg("renaming-utility", '\0', "launches the renaming utility instead of the main GUI");
     // set arguments to parser
@@ -206,7 +293,8 @@ int main(int argc, char *argv[])
     qtConfigArgs.qtWidgetsGuiArg().addSubArgument(&defaultFileArg);
     qtConfigArgs.qtWidgetsGuiArg().addSubArgument(&renamingUtilityArg);
     parser.setMainArguments({ &qtConfigArgs.qtWidgetsGuiArg(), &printFieldNamesArg, &displayFileInfoArg, &displayTagInfoArg,
-        &setTagInfoArgs.setTagInfoArg, &extractFieldArg, &exportArg, &genInfoArg, &timeSpanFormatArg, &noColorArg, &helpArg });
+        &setTagInfoArgs.setTagInfoArg, &extractFieldArg, &exportArg, &importArg, &genInfoArg, &validateOperationArg, &normalizeCoversArg,
+        &renameArg, &timeSpanFormatArg, &ioPriorityArg, &ioRateLimitArg, &noColorArg, &helpArg });
     // parse given arguments
     parser.parseArgs(argc, argv, ParseArgumentBehavior::CheckConstraints | ParseArgumentBehavior::ExitOnFailure);
 
@@ -222,8 +310,8 @@ int main(int argc, char *argv[])
              << "The tag editor has not been built with Qt widgets GUI support. Use --help to show the options of the CLI." << endl;
 #endif
     } else {
-        // apply general CLI config (concerns currently only the default time span output format)
-        Cli::applyGeneralConfig(timeSpanFormatArg);
+        // apply general CLI config (default time span output format and I/O scheduling)
+        Cli::applyGeneralConfig(timeSpanFormatArg, ioPriorityArg, ioRateLimitArg);
         // invoke specified CLI operation via callbacks
         parser.invokeCallbacks();
     }
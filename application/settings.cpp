@@ -66,6 +66,7 @@ void restore()
         break;
     }
     v.editor.saveAndShowNextOnEnter = settings.value(QStringLiteral("saveandshownextonenter"), false).toBool();
+    v.editor.saveInBackground = settings.value(QStringLiteral("saveinbackground"), true).toBool();
     v.editor.askBeforeDeleting = settings.value(QStringLiteral("askbeforedeleting"), true).toBool();
     switch (settings.value(QStringLiteral("multipletaghandling"), 0).toInt()) {
     case 0:
@@ -99,6 +100,8 @@ void restore()
     settings.beginGroup(QStringLiteral("filebrowser"));
     v.fileBrowser.hideBackupFiles = settings.value(QStringLiteral("hidebackupfiles"), true).toBool();
     v.fileBrowser.readOnly = settings.value(QStringLiteral("readonly"), true).toBool();
+    v.fileBrowser.prefetchNextFile = settings.value(QStringLiteral("prefetchnextfile"), true).toBool();
+    v.fileBrowser.showTagStatus = settings.value(QStringLiteral("showtagstatus"), true).toBool();
     settings.endGroup();
 
     settings.beginGroup(QStringLiteral("tagprocessing"));
@@ -204,6 +207,7 @@ void restore()
     v.renamingUtility.scriptSource = settings.value(QStringLiteral("src")).toInt();
     v.renamingUtility.externalScript = settings.value(QStringLiteral("file")).toString();
     v.renamingUtility.editorScript = settings.value(QStringLiteral("script")).toString();
+    v.renamingUtility.templateString = settings.value(QStringLiteral("template")).toString();
     settings.endGroup();
 
     v.qt.restore(settings);
@@ -217,6 +221,7 @@ void save()
     settings.beginGroup(QStringLiteral("editor"));
     settings.setValue(QStringLiteral("adoptfields"), static_cast<int>(v.editor.adoptFields));
     settings.setValue(QStringLiteral("saveandshownextonenter"), v.editor.saveAndShowNextOnEnter);
+    settings.setValue(QStringLiteral("saveinbackground"), v.editor.saveInBackground);
     settings.setValue(QStringLiteral("askbeforedeleting"), v.editor.askBeforeDeleting);
     settings.setValue(QStringLiteral("multipletaghandling"), static_cast<int>(v.editor.multipleTagHandling));
     settings.setValue(QStringLiteral("hidetagselectioncombobox"), v.editor.hideTagSelectionComboBox);
@@ -243,6 +248,8 @@ void save()
     settings.beginGroup(QStringLiteral("filebrowser"));
     settings.setValue(QStringLiteral("hidebackupfiles"), v.fileBrowser.hideBackupFiles);
     settings.setValue(QStringLiteral("readonly"), v.fileBrowser.readOnly);
+    settings.setValue(QStringLiteral("prefetchnextfile"), v.fileBrowser.prefetchNextFile);
+    settings.setValue(QStringLiteral("showtagstatus"), v.fileBrowser.showTagStatus);
     settings.endGroup();
 
     settings.beginGroup(QStringLiteral("tagprocessing"));
@@ -293,6 +300,7 @@ void save()
     settings.setValue(QStringLiteral("src"), v.renamingUtility.scriptSource);
     settings.setValue(QStringLiteral("file"), v.renamingUtility.externalScript);
     settings.setValue(QStringLiteral("script"), v.renamingUtility.editorScript);
+    settings.setValue(QStringLiteral("template"), v.renamingUtility.templateString);
     settings.endGroup();
 
     v.qt.save(settings);
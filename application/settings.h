@@ -36,6 +36,7 @@ struct Editor {
     std::string backupDirectory;
     AdoptFields adoptFields = AdoptFields::Never;
     bool saveAndShowNextOnEnter = false;
+    bool saveInBackground = true;
     bool askBeforeDeleting = true;
     MultipleTagHandling multipleTagHandling = MultipleTagHandling::SingleEditorPerTarget;
     bool hideTagSelectionComboBox = false;
@@ -54,6 +55,8 @@ enum class UnsupportedFieldHandling { Ignore, Discard };
 struct FileBrowser {
     bool hideBackupFiles = true;
     bool readOnly = true;
+    bool prefetchNextFile = true;
+    bool showTagStatus = true;
 };
 
 struct FileLayout {
@@ -97,6 +100,7 @@ struct RenamingUtility {
     int scriptSource = 0;
     QString externalScript;
     QString editorScript;
+    QString templateString;
 };
 
 struct Settings {
@@ -0,0 +1,143 @@
+#include "./cbor.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace Cli {
+namespace Cbor {
+
+/*!
+ * \class Writer
+ * \brief The Writer class encodes values as CBOR (RFC 7049) while they are visited.
+ *
+ * It implements RapidJSON's handler concept so a document or value can be encoded by passing the writer
+ * to RAPIDJSON_NAMESPACE::GenericValue::Accept(). Arrays and objects are encoded with indefinite length
+ * so nothing needs to be known in advance and the output can be streamed.
+ *
+ * Strings are encoded as byte strings if their data is contained by the set of byte strings passed to the
+ * constructor. This way the raw data referenced by Cli::Json::TagValue (when constructed with rawBinaryData)
+ * ends up as binary data instead of text. Byte strings can also be written explicitly via Bytes().
+ *
+ * The encoded data is buffered and only written to the stream when the buffer is full or the writer is
+ * flushed/destroyed.
+ */
+
+Writer::Writer(std::ostream &stream, const std::unordered_set<const Ch *> *byteStrings)
+    : m_stream(stream)
+    , m_byteStrings(byteStrings)
+{
+    m_buffer.reserve(bufferSize + 16);
+}
+
+Writer::~Writer()
+{
+    flush();
+}
+
+bool Writer::Null()
+{
+    writeByte(0xF6);
+    return true;
+}
+
+bool Writer::Bool(bool value)
+{
+    writeByte(value ? 0xF5 : 0xF4);
+    return true;
+}
+
+bool Writer::Int(int value)
+{
+    return Int64(value);
+}
+
+bool Writer::Uint(unsigned int value)
+{
+    return Uint64(value);
+}
+
+bool Writer::Int64(std::int64_t value)
+{
+    if (value < 0) {
+        writeHead(MajorType::NegativeInteger, static_cast<std::uint64_t>(-(value + 1)));
+    } else {
+        writeHead(MajorType::UnsignedInteger, static_cast<std::uint64_t>(value));
+    }
+    return true;
+}
+
+bool Writer::Uint64(std::uint64_t value)
+{
+    writeHead(MajorType::UnsignedInteger, value);
+    return true;
+}
+
+bool Writer::Double(double value)
+{
+    static_assert(sizeof(double) == sizeof(std::uint64_t), "double is 64-bit");
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeByte(0xFB);
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        writeByte(static_cast<std::uint8_t>(bits >> shift));
+    }
+    return true;
+}
+
+/*!
+ * \brief Writes the buffered data to the stream.
+ */
+void Writer::flush()
+{
+    m_stream.write(m_buffer.data(), static_cast<streamsize>(m_buffer.size()));
+    m_stream.flush();
+    m_buffer.clear();
+}
+
+/*!
+ * \brief Writes the initial byte of a data item and the additional bytes of its \a argument.
+ */
+void Writer::writeHead(MajorType majorType, std::uint64_t argument)
+{
+    const auto major = static_cast<std::uint8_t>(static_cast<std::uint8_t>(majorType) << 5);
+    int byteCount;
+    if (argument < 24) {
+        writeByte(static_cast<std::uint8_t>(major | argument));
+        return;
+    } else if (argument <= 0xFF) {
+        writeByte(major | 24);
+        byteCount = 1;
+    } else if (argument <= 0xFFFF) {
+        writeByte(major | 25);
+        byteCount = 2;
+    } else if (argument <= 0xFFFFFFFF) {
+        writeByte(major | 26);
+        byteCount = 4;
+    } else {
+        writeByte(major | 27);
+        byteCount = 8;
+    }
+    for (int shift = (byteCount - 1) * 8; shift >= 0; shift -= 8) {
+        writeByte(static_cast<std::uint8_t>(argument >> shift));
+    }
+}
+
+/*!
+ * \brief Writes a byte or text string.
+ * \remarks Large strings are written to the stream directly to avoid copying them into the buffer.
+ */
+void Writer::writeBytes(MajorType majorType, const Ch *data, std::size_t size)
+{
+    writeHead(majorType, size);
+    if (size >= bufferSize) {
+        flush();
+        m_stream.write(data, static_cast<streamsize>(size));
+        return;
+    }
+    m_buffer.append(data, size);
+    flushIfFull();
+}
+
+} // namespace Cbor
+} // namespace Cli
@@ -0,0 +1,122 @@
+#ifndef CLI_CBOR
+#define CLI_CBOR
+
+#include <rapidjson/rapidjson.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+
+namespace Cli {
+namespace Cbor {
+
+class Writer {
+public:
+    using Ch = char;
+
+    explicit Writer(std::ostream &stream, const std::unordered_set<const Ch *> *byteStrings = nullptr);
+    ~Writer();
+
+    bool Null();
+    bool Bool(bool value);
+    bool Int(int value);
+    bool Uint(unsigned int value);
+    bool Int64(std::int64_t value);
+    bool Uint64(std::uint64_t value);
+    bool Double(double value);
+    bool RawNumber(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy);
+    bool String(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy);
+    bool Bytes(const Ch *data, std::size_t size);
+    bool StartObject();
+    bool Key(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy);
+    bool EndObject(RAPIDJSON_NAMESPACE::SizeType memberCount = 0);
+    bool StartArray();
+    bool EndArray(RAPIDJSON_NAMESPACE::SizeType elementCount = 0);
+    void flush();
+
+private:
+    enum class MajorType : std::uint8_t { UnsignedInteger, NegativeInteger, ByteString, TextString, Array, Map, Tag, Simple };
+    void writeHead(MajorType majorType, std::uint64_t argument);
+    void writeBytes(MajorType majorType, const Ch *data, std::size_t size);
+    void writeByte(std::uint8_t byte);
+    void flushIfFull();
+
+    static constexpr std::size_t bufferSize = 0x10000;
+    std::ostream &m_stream;
+    std::string m_buffer;
+    const std::unordered_set<const Ch *> *m_byteStrings;
+};
+
+inline bool Writer::RawNumber(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool)
+{
+    writeBytes(MajorType::TextString, str, length);
+    return true;
+}
+
+inline bool Writer::String(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool)
+{
+    if (m_byteStrings && !m_byteStrings->empty() && m_byteStrings->find(str) != m_byteStrings->end()) {
+        return Bytes(str, length);
+    }
+    writeBytes(MajorType::TextString, str, length);
+    return true;
+}
+
+/*!
+ * \brief Writes the specified \a data as byte string.
+ */
+inline bool Writer::Bytes(const Ch *data, std::size_t size)
+{
+    writeBytes(MajorType::ByteString, data, size);
+    return true;
+}
+
+inline bool Writer::Key(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool)
+{
+    writeBytes(MajorType::TextString, str, length);
+    return true;
+}
+
+inline bool Writer::StartObject()
+{
+    writeByte(0xBF); // map of indefinite length
+    return true;
+}
+
+inline bool Writer::EndObject(RAPIDJSON_NAMESPACE::SizeType)
+{
+    writeByte(0xFF); // "break"
+    flushIfFull();
+    return true;
+}
+
+inline bool Writer::StartArray()
+{
+    writeByte(0x9F); // array of indefinite length
+    return true;
+}
+
+inline bool Writer::EndArray(RAPIDJSON_NAMESPACE::SizeType)
+{
+    writeByte(0xFF); // "break"
+    flushIfFull();
+    return true;
+}
+
+inline void Writer::writeByte(std::uint8_t byte)
+{
+    m_buffer += static_cast<char>(byte);
+}
+
+inline void Writer::flushIfFull()
+{
+    if (m_buffer.size() >= bufferSize) {
+        flush();
+    }
+}
+
+} // namespace Cbor
+} // namespace Cli
+
+#endif // CLI_CBOR
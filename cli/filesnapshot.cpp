@@ -0,0 +1,210 @@
+#include "./filesnapshot.h"
+#include "./helper.h"
+
+#include <c++utilities/application/global.h>
+#include <c++utilities/conversion/conversionexception.h>
+#include <c++utilities/conversion/stringbuilder.h>
+#include <c++utilities/conversion/stringconversion.h>
+#include <c++utilities/io/nativefilestream.h>
+
+#include <sys/stat.h>
+#ifdef PLATFORM_LINUX
+#include <fcntl.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <memory>
+
+using namespace std;
+using namespace CppUtilities;
+
+namespace Cli {
+
+/*!
+ * \class FileSnapshot
+ * \brief The FileSnapshot class records inode, size and modification time of files.
+ *
+ * It is used to determine which files have been added, changed or removed since a previous run so
+ * only those files need to be parsed again. The snapshot is stored as plain text where each line
+ * contains the inode, size, modification time (in nanoseconds since the epoch) and path of a file
+ * separated by tabs. Lines of files which could not be read are prefixed with "!"; those files are
+ * considered changed by the next run but not removed. Files are only considered removed when they
+ * do not exist anymore.
+ */
+
+/*!
+ * \brief Retrieves the snapshot entry for the specified \a path.
+ * \returns Returns whether the file could be stat'ed.
+ */
+static bool statFile(const char *path, FileSnapshotEntry &entry)
+{
+#if defined(PLATFORM_LINUX) && defined(STATX_BASIC_STATS)
+    struct statx stats;
+    if (statx(AT_FDCWD, path, 0, STATX_INO | STATX_SIZE | STATX_MTIME, &stats) != 0) {
+        return false;
+    }
+    entry.inode = stats.stx_ino;
+    entry.size = stats.stx_size;
+    entry.modificationTime = static_cast<std::int64_t>(stats.stx_mtime.tv_sec) * 1000000000 + stats.stx_mtime.tv_nsec;
+#else
+    struct stat stats;
+    if (stat(path, &stats) != 0) {
+        return false;
+    }
+    entry.inode = static_cast<std::uint64_t>(stats.st_ino);
+    entry.size = static_cast<std::uint64_t>(stats.st_size);
+#ifdef PLATFORM_LINUX
+    entry.modificationTime = static_cast<std::int64_t>(stats.st_mtim.tv_sec) * 1000000000 + stats.st_mtim.tv_nsec;
+#else
+    entry.modificationTime = static_cast<std::int64_t>(stats.st_mtime) * 1000000000;
+#endif
+#endif
+    return true;
+}
+
+/*!
+ * \brief Creates a snapshot of the specified \a paths.
+ * \remarks The files are stat'ed in parallel. Paths which can not be stat'ed are added to \a inaccessiblePaths
+ *          (if not nullptr). They are recorded as failed unless they do not exist anymore.
+ */
+FileSnapshot FileSnapshot::fromFiles(const std::vector<const char *> &paths, std::vector<const char *> *inaccessiblePaths)
+{
+    auto entries = make_unique<FileSnapshotEntry[]>(paths.size());
+    auto errorNumbers = make_unique<int[]>(paths.size());
+    runInParallel(paths.size(), [&](std::size_t index) { errorNumbers[index] = statFile(paths[index], entries[index]) ? 0 : errno; });
+
+    FileSnapshot snapshot;
+    snapshot.m_entries.reserve(paths.size());
+    for (std::size_t index = 0; index != paths.size(); ++index) {
+        if (!errorNumbers[index]) {
+            snapshot.m_entries[paths[index]] = entries[index];
+            continue;
+        }
+        if (errorNumbers[index] != ENOENT && errorNumbers[index] != ENOTDIR) {
+            snapshot.m_entries[paths[index]].failed = true;
+        }
+        if (inaccessiblePaths) {
+            inaccessiblePaths->emplace_back(paths[index]);
+        }
+    }
+    return snapshot;
+}
+
+/*!
+ * \brief Loads the snapshot stored at \a snapshotPath.
+ * \remarks Leaves the snapshot empty if the file does not exist (yet). Malformed lines are ignored so the
+ *          affected files are just considered changed.
+ * \throws Throws std::ios_base::failure when an IO error occurs.
+ */
+void FileSnapshot::load(const std::string &snapshotPath)
+{
+    m_entries.clear();
+    NativeFileStream file;
+    file.open(snapshotPath, ios_base::in | ios_base::binary);
+    if (!file.is_open()) {
+        if (errno == ENOENT) {
+            return;
+        }
+        throw ios_base::failure("unable to open snapshot \"" % snapshotPath + '\"');
+    }
+    for (string line; getline(file, line);) {
+        const auto failed = !line.empty() && line.front() == '!';
+        if (failed) {
+            line.erase(0, 1);
+        }
+        const auto inodeEnd = line.find('\t');
+        const auto sizeEnd = inodeEnd != string::npos ? line.find('\t', inodeEnd + 1) : string::npos;
+        const auto timeEnd = sizeEnd != string::npos ? line.find('\t', sizeEnd + 1) : string::npos;
+        if (timeEnd == string::npos || timeEnd + 1 == line.size()) {
+            continue;
+        }
+        try {
+            FileSnapshotEntry entry;
+            entry.inode = stringToNumber<std::uint64_t>(line.substr(0, inodeEnd));
+            entry.size = stringToNumber<std::uint64_t>(line.substr(inodeEnd + 1, sizeEnd - inodeEnd - 1));
+            entry.modificationTime = stringToNumber<std::int64_t>(line.substr(sizeEnd + 1, timeEnd - sizeEnd - 1));
+            entry.failed = failed;
+            m_entries[line.substr(timeEnd + 1)] = entry;
+        } catch (const ConversionException &) {
+        }
+    }
+    if (file.bad()) {
+        throw ios_base::failure("unable to read snapshot \"" % snapshotPath + '\"');
+    }
+}
+
+/*!
+ * \brief Stores the snapshot at \a snapshotPath.
+ * \remarks The snapshot is written to a temporary file first which is renamed afterwards so an aborted run
+ *          does not leave a truncated snapshot behind.
+ * \throws Throws std::ios_base::failure when an IO error occurs.
+ */
+void FileSnapshot::save(const std::string &snapshotPath) const
+{
+    const auto tempPath = snapshotPath + ".tmp";
+    {
+        NativeFileStream file;
+        file.exceptions(ios_base::failbit | ios_base::badbit);
+        file.open(tempPath, ios_base::out | ios_base::trunc | ios_base::binary);
+        for (const auto &entry : m_entries) {
+            // skip paths which could not be read back
+            if (entry.first.find('\n') != string::npos) {
+                continue;
+            }
+            if (entry.second.failed) {
+                file << '!';
+            }
+            file << entry.second.inode << '\t' << entry.second.size << '\t' << entry.second.modificationTime << '\t' << entry.first << '\n';
+        }
+        file.flush();
+    }
+    if (std::rename(tempPath.data(), snapshotPath.data()) != 0) {
+        throw ios_base::failure("unable to replace snapshot \"" % snapshotPath + '\"');
+    }
+}
+
+/*!
+ * \brief Returns whether the file at \a path has been added or changed since the \a previous snapshot.
+ * \remarks Files which could not be read when the \a previous snapshot was taken are always considered changed.
+ */
+bool FileSnapshot::hasChanged(const std::string &path, const FileSnapshot &previous) const
+{
+    const auto current = m_entries.find(path);
+    const auto old = previous.m_entries.find(path);
+    return current == m_entries.cend() || old == previous.m_entries.cend() || old->second.failed || current->second != old->second;
+}
+
+/*!
+ * \brief Returns the paths recorded in the \a previous snapshot which do not exist anymore.
+ * \remarks
+ * - Files recorded in the \a previous snapshot which have not been specified this time but still exist are taken over
+ *   into this snapshot so they are neither considered removed nor forgotten.
+ * - Files which have been specified but could not be read (see markFailed()) are not considered removed either.
+ */
+std::vector<string> FileSnapshot::takeOverUnspecified(const FileSnapshot &previous)
+{
+    vector<const std::pair<const string, FileSnapshotEntry> *> candidates;
+    for (const auto &entry : previous.m_entries) {
+        if (m_entries.find(entry.first) == m_entries.cend()) {
+            candidates.emplace_back(&entry);
+        }
+    }
+    auto errorNumbers = make_unique<int[]>(candidates.size());
+    runInParallel(candidates.size(), [&](std::size_t index) {
+        FileSnapshotEntry entry;
+        errorNumbers[index] = statFile(candidates[index]->first.data(), entry) ? 0 : errno;
+    });
+
+    std::vector<string> removedPaths;
+    for (std::size_t index = 0; index != candidates.size(); ++index) {
+        if (errorNumbers[index] == ENOENT || errorNumbers[index] == ENOTDIR) {
+            removedPaths.emplace_back(candidates[index]->first);
+        } else {
+            m_entries.emplace(*candidates[index]);
+        }
+    }
+    return removedPaths;
+}
+
+} // namespace Cli
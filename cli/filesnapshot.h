@@ -0,0 +1,67 @@
+#ifndef CLI_FILE_SNAPSHOT
+#define CLI_FILE_SNAPSHOT
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cli {
+
+struct FileSnapshotEntry {
+    bool operator==(const FileSnapshotEntry &other) const;
+    bool operator!=(const FileSnapshotEntry &other) const;
+
+    std::uint64_t inode = 0;
+    std::uint64_t size = 0;
+    std::int64_t modificationTime = 0;
+    bool failed = false;
+};
+
+inline bool FileSnapshotEntry::operator==(const FileSnapshotEntry &other) const
+{
+    return inode == other.inode && size == other.size && modificationTime == other.modificationTime;
+}
+
+inline bool FileSnapshotEntry::operator!=(const FileSnapshotEntry &other) const
+{
+    return !(*this == other);
+}
+
+class FileSnapshot {
+public:
+    static FileSnapshot fromFiles(const std::vector<const char *> &paths, std::vector<const char *> *inaccessiblePaths = nullptr);
+    void load(const std::string &snapshotPath);
+    void save(const std::string &snapshotPath) const;
+    bool hasChanged(const std::string &path, const FileSnapshot &previous) const;
+    std::vector<std::string> takeOverUnspecified(const FileSnapshot &previous);
+    void markFailed(const std::string &path);
+    std::size_t size() const;
+
+private:
+    std::unordered_map<std::string, FileSnapshotEntry> m_entries;
+};
+
+/*!
+ * \brief Marks the entry for the specified \a path as failed so it is considered changed by the next run.
+ * \remarks The entry is kept so the file is not considered removed. Does nothing if there is no entry for \a path (eg.
+ *          because the file does not exist anymore).
+ */
+inline void FileSnapshot::markFailed(const std::string &path)
+{
+    if (const auto entry = m_entries.find(path); entry != m_entries.end()) {
+        entry->second.failed = true;
+    }
+}
+
+/*!
+ * \brief Returns the number of files recorded within the snapshot.
+ */
+inline std::size_t FileSnapshot::size() const
+{
+    return m_entries.size();
+}
+
+} // namespace Cli
+
+#endif // CLI_FILE_SNAPSHOT
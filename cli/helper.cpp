@@ -14,10 +14,17 @@
 #include <c++utilities/io/ansiescapecodes.h>
 
 #include <unistd.h>
+#ifdef PLATFORM_LINUX
+#include <sys/syscall.h>
+#endif
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <csignal>
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 using namespace std;
 using namespace std::placeholders;
@@ -162,6 +169,7 @@ printDiagMsg:
             setStyle(cout, TextAttribute::Reset);
             break;
         case DiagLevel::Critical:
+        case DiagLevel::Fatal:
             setStyle(cout, Color::Red, ColorContext::Foreground, TextAttribute::Bold);
             setStyle(cout, TextAttribute::Reset);
             setStyle(cout, TextAttribute::Bold);
@@ -209,16 +217,11 @@ void printProperty(const char *propName, ElementPosition elementPosition, const
 
 void printFieldName(const char *fieldName, size_t fieldNameLen)
 {
+    static constexpr char padding[] = "                  ";
+    static constexpr auto paddingSize = sizeof(padding) - 1;
     cout << "    " << fieldName;
-    // also write padding
-    if (fieldNameLen >= 18) {
-        // write at least one space
-        cout << ' ';
-        return;
-    }
-    for (auto i = fieldNameLen; i < 18; ++i) {
-        cout << ' ';
-    }
+    // also write padding (at least one space)
+    cout.write(padding, static_cast<streamsize>(fieldNameLen < paddingSize ? paddingSize - fieldNameLen : 1));
 }
 
 void printTagValue(const TagValue &value)
@@ -307,6 +310,115 @@ void printNativeFields(const Tag *tag)
     }
 }
 
+OutputFormat parseOutputFormat(const Argument &formatArg, OutputFormat defaultFormat)
+{
+    if (formatArg.isPresent()) {
+        const auto &val = formatArg.values().front();
+        if (!strcmp(val, "human")) {
+            return OutputFormat::Human;
+        } else if (!strcmp(val, "tsv")) {
+            return OutputFormat::Tsv;
+        } else if (!strcmp(val, "csv")) {
+            return OutputFormat::Csv;
+        } else {
+            cerr << Phrases::Error << "The specified output format \"" << val << "\" is invalid." << Phrases::End
+                 << "note: Valid formats are human, tsv and csv." << endl;
+            exit(-1);
+        }
+    }
+    return defaultFormat;
+}
+
+/*!
+ * \class TableWriter
+ * \brief The TableWriter class writes tab or comma separated values to a stream.
+ *
+ * Cells are escaped according to the format (TSV values use backslash escapes for tabs, line breaks and
+ * backslashes; CSV values are quoted as described in RFC 4180) and collected within a buffer which is
+ * only written to the stream when it is full or when the writer is flushed/destroyed.
+ */
+
+TableWriter::TableWriter(ostream &stream, OutputFormat format)
+    : m_stream(stream)
+    , m_separator(format == OutputFormat::Csv ? ',' : '\t')
+    , m_rowStarted(false)
+    , m_format(format)
+{
+    m_buffer.reserve(bufferSize);
+}
+
+TableWriter::~TableWriter()
+{
+    flush();
+}
+
+/*!
+ * \brief Adds a cell with the specified \a value to the current row.
+ */
+void TableWriter::addCell(const char *value, std::size_t valueSize)
+{
+    if (m_rowStarted) {
+        m_buffer += m_separator;
+    }
+    m_rowStarted = true;
+    const char *const end = value + valueSize;
+    if (m_format == OutputFormat::Csv) {
+        if (find_if(value, end, [](char c) { return c == ',' || c == '"' || c == '\n' || c == '\r'; }) == end) {
+            m_buffer.append(value, valueSize);
+            return;
+        }
+        m_buffer += '"';
+        for (const char *c = value; c != end; ++c) {
+            if (*c == '"') {
+                m_buffer += '"';
+            }
+            m_buffer += *c;
+        }
+        m_buffer += '"';
+        return;
+    }
+    for (const char *c = value; c != end; ++c) {
+        switch (*c) {
+        case '\t':
+            m_buffer += "\\t";
+            break;
+        case '\n':
+            m_buffer += "\\n";
+            break;
+        case '\r':
+            m_buffer += "\\r";
+            break;
+        case '\\':
+            m_buffer += "\\\\";
+            break;
+        default:
+            m_buffer += *c;
+        }
+    }
+}
+
+/*!
+ * \brief Terminates the current row.
+ */
+void TableWriter::endRow()
+{
+    m_buffer += m_format == OutputFormat::Csv ? "\r\n" : "\n";
+    m_rowStarted = false;
+    if (m_buffer.size() >= bufferSize) {
+        flush();
+    }
+}
+
+/*!
+ * \brief Writes the buffered rows to the stream.
+ */
+void TableWriter::flush()
+{
+    m_stream.write(m_buffer.data(), static_cast<streamsize>(m_buffer.size()));
+    m_stream.flush();
+    m_buffer.clear();
+}
+
 TimeSpanOutputFormat parseTimeSpanOutputFormat(const Argument &timeSpanFormatArg, TimeSpanOutputFormat defaultFormat)
 {
     if (timeSpanFormatArg.isPresent()) {
@@ -585,8 +697,12 @@ FieldDenotations parseFieldDenotations(const Argument &fieldsArg, bool readOnly)
             type = DenotationType::File;
         }
 
-        // add field denotation scope
+        // add field denotation scope (and remember the order in which the scopes have been specified)
+        const auto scopeCount = fields.size();
         auto &fieldValues = fields[scope];
+        if (fields.size() != scopeCount) {
+            fieldValues.index = scopeCount;
+        }
         // add value to the scope (if present)
         if (equationPos) {
             if (readOnly) {
@@ -724,6 +840,141 @@ bool stringToBool(const string &str)
     throw ConversionException(argsToString('\"', str, "\" is not yes or no"));
 }
 
+/*!
+ * \brief Applies the I/O scheduling class specified via \a ioPriorityArg to the current process.
+ * \remarks Only supported under Linux. Using "idle" ensures the process only gets disk time when no other
+ *          process needs it so batch operations don't starve latency-sensitive readers.
+ */
+void applyIoPriority(const Argument &ioPriorityArg)
+{
+    if (!ioPriorityArg.isPresent()) {
+        return;
+    }
+    const auto &val = ioPriorityArg.values().front();
+    // see ioprio_set(2) for the values of the classes; the level (0 is highest, 7 is lowest) is kept at the default of 4
+    // because level 0 would raise the priority above the one of other processes
+    int ioPrioClass, ioPrioLevel = 4;
+    if (!strcmp(val, "realtime")) {
+        ioPrioClass = 1;
+    } else if (!strcmp(val, "best-effort")) {
+        ioPrioClass = 2;
+    } else if (!strcmp(val, "normal")) {
+        // use the class "none" which restores the default behavior (priority derived from the CPU nice value)
+        ioPrioClass = 0;
+        ioPrioLevel = 0;
+    } else if (!strcmp(val, "idle")) {
+        ioPrioClass = 3;
+        ioPrioLevel = 0;
+    } else {
+        cerr << Phrases::Error << "The specified I/O priority \"" << val << "\" is invalid." << Phrases::End
+             << "note: Valid priorities are idle, normal and realtime." << endl;
+        exit(-1);
+    }
+#if defined(PLATFORM_LINUX) && defined(SYS_ioprio_set)
+    static constexpr int ioPrioWhoProcess = 1, ioPrioClassShift = 13;
+    if (syscall(SYS_ioprio_set, ioPrioWhoProcess, 0, (ioPrioClass << ioPrioClassShift) | ioPrioLevel) != 0) {
+        cerr << Phrases::Warning << "Unable to set the I/O priority to \"" << val << "\": " << strerror(errno) << Phrases::EndFlush;
+    }
+#else
+    CPP_UTILITIES_UNUSED(ioPrioClass)
+    CPP_UTILITIES_UNUSED(ioPrioLevel)
+    cerr << Phrases::Warning << "Setting the I/O priority is not supported on this platform." << Phrases::EndFlush;
+#endif
+}
+
+/*!
+ * \brief Returns the I/O rate limit specified via \a ioRateLimitArg in byte per second.
+ * \remarks The argument value is expected to be in MiB/s and might be a floating point number. Returns zero
+ *          if the argument is not present (meaning no limit).
+ */
+std::uint64_t parseIoRateLimit(const Argument &ioRateLimitArg)
+{
+    if (!ioRateLimitArg.isPresent()) {
+        return 0;
+    }
+    try {
+        const auto mibPerSecond = stringToNumber<double>(string(ioRateLimitArg.values().front()));
+        if (mibPerSecond <= 0.0) {
+            throw ConversionException("rate limit must be positive");
+        }
+        return static_cast<std::uint64_t>(mibPerSecond * 1024.0 * 1024.0);
+    } catch (const ConversionException &) {
+        cerr << Phrases::Error << "The specified I/O rate limit \"" << ioRateLimitArg.values().front() << "\" is invalid." << Phrases::End
+             << "note: The rate limit must be a positive number in MiB/s." << endl;
+        exit(-1);
+    }
+}
+
+std::uint64_t ioRateLimit = 0;
+/// \brief The point in time (in ticks of std::chrono::steady_clock) until which the I/O rate limit has been used up.
+static std::atomic<std::chrono::steady_clock::rep> ioThrottlingReservedUntil(0);
+
+/*!
+ * \brief Constructs a throttle for writing a file which processes about \a bytesPerStep within each step.
+ * \remarks Usually \a bytesPerStep is the size of the file being rewritten because that is the amount
+ *          of data copied when the file is rewritten.
+ */
+IoThrottle::IoThrottle(std::uint64_t bytesPerStep)
+    : m_bytesPerStep(bytesPerStep)
+    , m_processedBytes(0)
+{
+}
+
+/*!
+ * \brief Starts throttling the next step.
+ */
+void IoThrottle::nextStep()
+{
+    m_processedBytes = 0;
+}
+
+/*!
+ * \brief Paces the current step of \a progress so the estimated total throughput does not exceed ioRateLimit.
+ * \remarks The amount of data processed since the last call is estimated from the step percentage and reserved
+ *          from the rate limit shared by all threads. Sleeps in small slices so aborting (see InterruptHandler) is
+ *          not delayed noticeably.
+ */
+void IoThrottle::throttle(const AbortableProgressFeedback &progress)
+{
+    if (!ioRateLimit || !m_bytesPerStep) {
+        return;
+    }
+    const auto processedBytes = static_cast<std::uint64_t>(static_cast<double>(m_bytesPerStep) * progress.stepPercentage() / 100.0);
+    if (processedBytes <= m_processedBytes) {
+        return;
+    }
+    const auto requiredDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(processedBytes - m_processedBytes) / static_cast<double>(ioRateLimit)));
+    m_processedBytes = processedBytes;
+
+    // reserve the time required for the processed bytes after the time reserved by other writers (or now)
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto reservedUntil = ioThrottlingReservedUntil.load();
+    auto targetTicks = reservedUntil;
+    do {
+        targetTicks = std::max(reservedUntil, now) + requiredDuration.count();
+    } while (!ioThrottlingReservedUntil.compare_exchange_weak(reservedUntil, targetTicks));
+
+    const auto targetTime = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(targetTicks));
+    static constexpr auto maxSleepSlice = std::chrono::milliseconds(100);
+    for (auto current = std::chrono::steady_clock::now(); current < targetTime && !progress.isAborted();
+         current = std::chrono::steady_clock::now()) {
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(targetTime - current, maxSleepSlice));
+    }
+}
+
+/*!
+ * \brief Applies the changes of \a fileInfo without printing the progress, respecting ioRateLimit.
+ * \remarks Used by operations writing multiple files in parallel; might be called from multiple threads at the same time.
+ */
+void applyChangesWithIoRateLimit(MediaFileInfo &fileInfo, Diagnostics &diag)
+{
+    IoThrottle throttle(fileInfo.size());
+    AbortableProgressFeedback progress([&throttle](AbortableProgressFeedback &) { throttle.nextStep(); },
+        [&throttle](AbortableProgressFeedback &progress) { throttle.throttle(progress); });
+    fileInfo.applyChanges(diag, progress);
+}
+
 bool logLineFinalized = true;
 static string lastStep;
 void logNextStep(const AbortableProgressFeedback &progress)
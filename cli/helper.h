@@ -12,7 +12,12 @@
 #include <c++utilities/misc/flagenumclass.h>
 #include <c++utilities/misc/traits.h>
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <ostream>
+#include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -232,6 +237,7 @@ namespace Cli {
 struct FieldValues {
     std::vector<FieldValue> allValues;
     std::vector<FieldValue *> relevantValues;
+    std::size_t index = 0;
 };
 using FieldDenotations = std::unordered_map<FieldScope, FieldValues>;
 
@@ -283,6 +289,32 @@ inline void printProperty(
 void printField(const FieldScope &scope, const Tag *tag, TagType tagType, bool skipEmpty);
 void printNativeFields(const Tag *tag);
 
+enum class OutputFormat { Human, Tsv, Csv };
+OutputFormat parseOutputFormat(const CppUtilities::Argument &formatArg, OutputFormat defaultFormat);
+
+class TableWriter {
+public:
+    TableWriter(std::ostream &stream, OutputFormat format);
+    ~TableWriter();
+    void addCell(const char *value, std::size_t valueSize);
+    void addCell(const std::string &value);
+    void endRow();
+    void flush();
+
+private:
+    static constexpr std::size_t bufferSize = 0x10000;
+    std::ostream &m_stream;
+    std::string m_buffer;
+    const char m_separator;
+    bool m_rowStarted;
+    const OutputFormat m_format;
+};
+
+inline void TableWriter::addCell(const std::string &value)
+{
+    addCell(value.data(), value.size());
+}
+
 CppUtilities::TimeSpanOutputFormat parseTimeSpanOutputFormat(
     const CppUtilities::Argument &usageArg, CppUtilities::TimeSpanOutputFormat defaultFormat);
 TagUsage parseUsageDenotation(const CppUtilities::Argument &usageArg, TagUsage defaultUsage);
@@ -294,6 +326,61 @@ bool applyTargetConfiguration(TagTarget &target, const std::string &configStr);
 FieldDenotations parseFieldDenotations(const CppUtilities::Argument &fieldsArg, bool readOnly);
 std::string tagName(const Tag *tag);
 bool stringToBool(const std::string &str);
+/*!
+ * \brief Invokes \a function for each index within [0, \a count) using up to \a threadCount threads.
+ * \remarks Uses as many threads as hardware threads are available if \a threadCount is zero. The \a function
+ *          must be thread-safe and must not throw.
+ */
+template <typename Function> void runInParallel(std::size_t count, Function function, unsigned int threadCount = 0)
+{
+    if (!threadCount) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, count));
+    if (threadCount <= 1) {
+        for (std::size_t index = 0; index != count; ++index) {
+            function(index);
+        }
+        return;
+    }
+    std::atomic<std::size_t> nextIndex(0);
+    const auto worker = [&] {
+        for (std::size_t index; (index = nextIndex++) < count;) {
+            function(index);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned int i = 1; i != threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void applyIoPriority(const CppUtilities::Argument &ioPriorityArg);
+std::uint64_t parseIoRateLimit(const CppUtilities::Argument &ioRateLimitArg);
+extern std::uint64_t ioRateLimit;
+
+/*!
+ * \brief The IoThrottle class paces writing a single file so the total throughput does not exceed ioRateLimit.
+ * \remarks Each file being written uses its own instance; the rate limit is shared by all instances so it applies
+ *          to all files being written in parallel in total.
+ */
+class IoThrottle {
+public:
+    explicit IoThrottle(std::uint64_t bytesPerStep);
+    void nextStep();
+    void throttle(const TagParser::AbortableProgressFeedback &progress);
+
+private:
+    std::uint64_t m_bytesPerStep;
+    std::uint64_t m_processedBytes;
+};
+
+void applyChangesWithIoRateLimit(TagParser::MediaFileInfo &fileInfo, TagParser::Diagnostics &diag);
 extern bool logLineFinalized;
 void logNextStep(const TagParser::AbortableProgressFeedback &progress);
 void logStepPercentage(const TagParser::AbortableProgressFeedback &progress);
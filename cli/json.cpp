@@ -8,6 +8,8 @@
 
 #include <c++utilities/conversion/stringconversion.h>
 
+#include <limits>
+
 using namespace std;
 using namespace CppUtilities;
 using namespace TagParser;
@@ -34,10 +36,26 @@ inline void push<Cli::Json::TagValue::ValueAllowedToMove>(
 namespace Cli {
 namespace Json {
 
+/*!
+ * \brief Makes \a value reference the raw data of the specified \a tagValue (without any encoding and without copying it).
+ * \remarks The data is registered in \a rawBinaryData so encoders can tell it apart from text.
+ */
+static void pushRawData(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Value &value, RawBinaryData &rawBinaryData)
+{
+    if (tagValue.dataSize() > numeric_limits<RAPIDJSON_NAMESPACE::SizeType>::max()) {
+        throw ConversionException("size is too big");
+    }
+    value.SetString(RAPIDJSON_NAMESPACE::StringRef(tagValue.dataPointer(), static_cast<RAPIDJSON_NAMESPACE::SizeType>(tagValue.dataSize())));
+    rawBinaryData.emplace(tagValue.dataPointer());
+}
+
 /*!
  * \brief Converts the specified TagParser::TagValue to an object suitable for JSON serialization.
+ * \remarks Binary data (eg. pictures) is Base64-encoded unless \a rawBinaryData is specified. Otherwise the value references
+ *          the raw data which must outlive the value and the data is added to \a rawBinaryData. Raw data is only suitable for
+ *          binary encoders such as Cli::Cbor::Writer.
  */
-TagValue::TagValue(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
+TagValue::TagValue(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator, RawBinaryData *rawBinaryData)
     : mimeType(tagValue.mimeType())
 {
     if (tagValue.isEmpty()) {
@@ -74,6 +92,11 @@ TagValue::TagValue(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Doc
             ReflectiveRapidJSON::JsonReflector::push(tagValue.toDateTime(), value, allocator);
             break;
         case TagDataType::Picture:
+            if (rawBinaryData) {
+                pushRawData(tagValue, value, *rawBinaryData);
+                kind = "picture";
+                break;
+            }
             if (tagValue.dataSize() > (1024 * 1024)) {
                 throw ConversionException("size is too big");
             }
@@ -81,6 +104,11 @@ TagValue::TagValue(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Doc
             kind = "picture";
             break;
         case TagDataType::Binary:
+            if (rawBinaryData) {
+                pushRawData(tagValue, value, *rawBinaryData);
+                kind = "binary";
+                break;
+            }
             if (tagValue.dataSize() > (1024 * 1024)) {
                 throw ConversionException("size is too big");
             }
@@ -114,7 +142,7 @@ TargetInfo::TargetInfo(const TagTarget &tagTarget, RAPIDJSON_NAMESPACE::Document
 /*!
  * \brief Copies relevant information from TagParser::Tag for serialization (especially the fields).
  */
-TagInfo::TagInfo(const Tag &tag, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
+TagInfo::TagInfo(const Tag &tag, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator, RawBinaryData *rawBinaryData)
     : format(tag.typeName())
     , target(tag.target(), allocator)
 {
@@ -126,7 +154,7 @@ TagInfo::TagInfo(const Tag &tag, RAPIDJSON_NAMESPACE::Document::AllocatorType &a
         std::vector<TagValue> valueObjects;
         valueObjects.reserve(tagValues.size());
         for (const auto *tagValue : tagValues) {
-            valueObjects.emplace_back(*tagValue, allocator);
+            valueObjects.emplace_back(*tagValue, allocator, rawBinaryData);
         }
         fields.insert(make_pair(FieldMapping::fieldDenotation(field), move(valueObjects)));
     }
@@ -136,7 +164,8 @@ TagInfo::TagInfo(const Tag &tag, RAPIDJSON_NAMESPACE::Document::AllocatorType &a
  * \brief Copies relevant information from TagParser::MediaFileInfo for serialization.
  * \remarks The \a mediaFileInfo must have been parsed before.
  */
-FileInfo::FileInfo(const TagParser::MediaFileInfo &mediaFileInfo, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
+FileInfo::FileInfo(
+    const TagParser::MediaFileInfo &mediaFileInfo, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator, RawBinaryData *rawBinaryData)
     : fileName(mediaFileInfo.fileName())
     , size(mediaFileInfo.size())
     , mimeType(mediaFileInfo.mimeType())
@@ -144,7 +173,7 @@ FileInfo::FileInfo(const TagParser::MediaFileInfo &mediaFileInfo, RAPIDJSON_NAME
     , duration(mediaFileInfo.duration())
 {
     for (const Tag *tag : mediaFileInfo.tags()) {
-        tags.emplace_back(*tag, allocator);
+        tags.emplace_back(*tag, allocator, rawBinaryData);
     }
 }
 
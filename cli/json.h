@@ -7,7 +7,9 @@
 
 #include <c++utilities/chrono/timespan.h>
 
+#include <map>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace TagParser {
 class MediaFileInfo;
@@ -18,8 +20,11 @@ class TagValue;
 namespace Cli {
 namespace Json {
 
+/// \brief Holds the pointers of the strings which reference raw binary data (see TagValue::TagValue()).
+using RawBinaryData = std::unordered_set<const char *>;
+
 struct TagValue : ReflectiveRapidJSON::JsonSerializable<TagValue> {
-    TagValue(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator);
+    TagValue(const TagParser::TagValue &tagValue, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator, RawBinaryData *rawBinaryData = nullptr);
 
     const char *kind = "undefined";
     const std::string mimeType;
@@ -40,7 +45,7 @@ struct TargetInfo : ReflectiveRapidJSON::JsonSerializable<TargetInfo> {
 };
 
 struct TagInfo : ReflectiveRapidJSON::JsonSerializable<TagInfo> {
-    TagInfo(const TagParser::Tag &tag, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator);
+    TagInfo(const TagParser::Tag &tag, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator, RawBinaryData *rawBinaryData = nullptr);
 
     const char *format = nullptr;
     TargetInfo target;
@@ -48,7 +53,8 @@ struct TagInfo : ReflectiveRapidJSON::JsonSerializable<TagInfo> {
 };
 
 struct FileInfo : ReflectiveRapidJSON::JsonSerializable<FileInfo> {
-    FileInfo(const TagParser::MediaFileInfo &mediaFileInfo, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator);
+    FileInfo(const TagParser::MediaFileInfo &mediaFileInfo, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator,
+        RawBinaryData *rawBinaryData = nullptr);
 
     std::string fileName;
     std::size_t size;
@@ -58,6 +64,11 @@ struct FileInfo : ReflectiveRapidJSON::JsonSerializable<FileInfo> {
     CppUtilities::TimeSpan duration;
 };
 
+struct FileInfoDelta : ReflectiveRapidJSON::JsonSerializable<FileInfoDelta> {
+    std::map<std::string, FileInfo> changed;
+    std::vector<std::string> removed;
+};
+
 }
 }
 
@@ -1,14 +1,23 @@
 #include "./mainfeatures.h"
 #include "./attachmentinfo.h"
+#include "./fieldmapping.h"
 #include "./helper.h"
 #ifdef TAGEDITOR_JSON_EXPORT
+#include "./cbor.h"
+#include "./filesnapshot.h"
 #include "./json.h"
 #endif
 
 #include "../application/knownfieldmodel.h"
+#include "../renamingutility/renamingplan.h"
+#include "../renamingutility/renamingtemplate.h"
 #if defined(TAGEDITOR_GUI_QTWIDGETS) || defined(TAGEDITOR_GUI_QTQUICK)
 #include "../misc/htmlinfo.h"
 #include "../misc/utility.h"
+#if defined(TAGEDITOR_GUI_QTWIDGETS) && !defined(TAGEDITOR_NO_JSENGINE)
+#include "../renamingutility/filesystemitem.h"
+#include "../renamingutility/renamingengine.h"
+#endif
 #endif
 
 #include "resources/config.h"
@@ -18,11 +27,14 @@
 #include <tagparser/abstracttrack.h>
 #include <tagparser/backuphelper.h>
 #include <tagparser/diagnostics.h>
+#include <tagparser/id3/id3v2tag.h>
 #include <tagparser/language.h>
 #include <tagparser/mediafileinfo.h>
+#include <tagparser/mp4/mp4tag.h>
 #include <tagparser/progressfeedback.h>
 #include <tagparser/tag.h>
 #include <tagparser/tagvalue.h>
+#include <tagparser/vorbis/vorbiscomment.h>
 
 #ifdef TAGEDITOR_JSON_EXPORT
 #include <reflective_rapidjson/json/reflector.h>
@@ -37,11 +49,24 @@
 #include <c++utilities/misc/parseerror.h>
 
 #if defined(TAGEDITOR_GUI_QTWIDGETS) || defined(TAGEDITOR_GUI_QTQUICK)
+#include <QBuffer>
+#include <QCoreApplication>
 #include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QPainter>
+#include <QThreadPool>
+#include <QUrl>
 #include <qtutilities/misc/conversion.h>
 #endif
 
 #ifdef TAGEDITOR_JSON_EXPORT
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/istreamwrapper.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/writer.h>
@@ -49,9 +74,12 @@
 
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 
 using namespace std;
 using namespace CppUtilities;
@@ -96,11 +124,137 @@ void printFieldNames(const ArgumentOccurrence &)
          << flush;
 }
 
-void generateFileInfo(const ArgumentOccurrence &, const Argument &inputFileArg, const Argument &outputFileArg, const Argument &validateArg)
+#if defined(TAGEDITOR_GUI_QTWIDGETS) || defined(TAGEDITOR_GUI_QTQUICK)
+/*!
+ * \brief Writes the specified \a data to the file \a fileName within \a dir.
+ * \returns Returns whether the data could be written.
+ */
+static bool writeReportFile(const QDir &dir, const QString &fileName, const QByteArray &data)
+{
+    QFile file(dir.filePath(fileName));
+    return file.open(QFile::WriteOnly | QFile::Truncate) && file.write(data) == data.size() && file.flush();
+}
+
+/*!
+ * \brief Generates HTML info for multiple files at once.
+ *
+ * Writes one document per file, an index and the style sheet/script shared by all documents to \a outputDir.
+ * Directories are scanned recursively. Files are processed in parallel.
+ */
+static void generateFileInfoForMultipleFiles(const Argument &inputFilesArg, const char *outputDir, const Argument &validateArg, const Argument &jobsArg)
+{
+    // determine files
+    vector<QString> paths;
+    for (const char *const path : inputFilesArg.values()) {
+        const auto qpath = fromNativeFileName(path);
+        if (!QFileInfo(qpath).isDir()) {
+            paths.emplace_back(qpath);
+            continue;
+        }
+        const auto firstFileOfDir = paths.size();
+        for (QDirIterator i(qpath, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories); i.hasNext();) {
+            paths.emplace_back(i.next());
+        }
+        sort(paths.begin() + static_cast<ptrdiff_t>(firstFileOfDir), paths.end());
+    }
+
+    // write assets shared by all documents
+    const QDir dir(fromNativeFileName(outputDir));
+    if (!dir.mkpath(QStringLiteral(".")) || !writeReportFile(dir, QStringLiteral("style.css"), HtmlInfo::generateStyleSheet())
+        || !writeReportFile(dir, QStringLiteral("script.js"), HtmlInfo::generateScript())) {
+        cerr << Phrases::Error << "An IO error occured when writing to the directory \"" << outputDir << "\"." << Phrases::EndFlush;
+        exit(-1);
+    }
+
+    // stop processing further files when interrupted
+    atomic<bool> aborted(false);
+    const InterruptHandler handler([&aborted] { aborted = true; });
+
+    // generate documents in parallel
+    vector<HtmlInfo::IndexEntry> entries(paths.size());
+    const auto assetPrefix = QStringLiteral("./");
+    const auto numberWidth = QString::number(paths.size()).size();
+    mutex outputMutex;
+    runInParallel(
+        paths.size(),
+        [&](size_t index) {
+            if (aborted) {
+                return;
+            }
+            const auto &path = paths[index];
+            auto &entry = entries[index];
+            entry.path = QDir::toNativeSeparators(path);
+            const auto documentName = QStringLiteral("%1-%2.xhtml").arg(index + 1, numberWidth, 10, QChar('0')).arg(QFileInfo(path).fileName());
+            const auto nativePath = toNativeFileName(path);
+            const char *failure = nullptr;
+            try {
+                MediaFileInfo fileInfo(string(nativePath.data(), static_cast<size_t>(nativePath.size())));
+                fileInfo.setForceFullParse(validateArg.isPresent());
+                fileInfo.open(true);
+                Diagnostics diag, diagReparsing;
+                fileInfo.parseEverything(diag);
+                entry.container = QString::fromUtf8(fileInfo.containerFormatName());
+                entry.size = QString::fromStdString(dataSizeToString(fileInfo.size(), true));
+                const auto duration = fileInfo.duration();
+                if (!duration.isNull()) {
+                    entry.duration = QString::fromStdString(duration.toString(TimeSpanOutputFormat::WithMeasures));
+                }
+                entry.notifications = diag.empty()
+                    ? QStringLiteral("0")
+                    : QStringLiteral("%1 (%2)").arg(diag.size()).arg(QString::fromUtf8(diagLevelName(diag.level())));
+                if (writeReportFile(dir, documentName, HtmlInfo::generateInfo(fileInfo, diag, diagReparsing, assetPrefix))) {
+                    // percent-encode the file name so characters like "#", "?" and "%" don't break the link
+                    entry.link = assetPrefix + QString::fromLatin1(QUrl::toPercentEncoding(documentName));
+                } else {
+                    failure = "An IO error occured when writing the file information for";
+                }
+            } catch (const TagParser::Failure &) {
+                failure = "A parsing failure occured when reading the file";
+            } catch (const std::ios_base::failure &) {
+                failure = "An IO failure occured when reading the file";
+            }
+            if (failure) {
+                entry.notifications = QString::fromUtf8(failure);
+            }
+            const lock_guard<mutex> outputLock(outputMutex);
+            if (failure) {
+                cerr << Phrases::Error << failure << " \"" << nativePath.data() << "\"." << Phrases::EndFlush;
+            } else {
+                cout << "File information for \"" << nativePath.data() << "\" has been saved." << endl;
+            }
+        },
+        static_cast<unsigned int>(parseUInt64(jobsArg, 0)));
+
+    // write index
+    if (!writeReportFile(dir, QStringLiteral("index.xhtml"), HtmlInfo::generateIndex(entries, assetPrefix))) {
+        cerr << Phrases::Error << "An IO error occured when writing the index to \"" << outputDir << "\"." << Phrases::EndFlush;
+        exit(-1);
+    }
+    if (aborted) {
+        cerr << Phrases::Warning << "The operation has been aborted; the index only links the files processed so far." << Phrases::EndFlush;
+    }
+    cout << "The index has been saved to \"" << outputDir << "\"." << endl;
+}
+#endif
+
+void generateFileInfo(const ArgumentOccurrence &, const Argument &inputFileArg, const Argument &outputFileArg, const Argument &outputDirArg,
+    const Argument &validateArg, const Argument &jobsArg)
 {
     CMD_UTILS_START_CONSOLE;
 
 #if defined(TAGEDITOR_GUI_QTWIDGETS) || defined(TAGEDITOR_GUI_QTQUICK)
+    if (outputDirArg.isPresent()) {
+        if (outputFileArg.isPresent()) {
+            cerr << Phrases::Error << "An output file and an output directory must not be specified at the same time." << Phrases::EndFlush;
+            exit(-1);
+        }
+        generateFileInfoForMultipleFiles(inputFileArg, outputDirArg.values().front(), validateArg, jobsArg);
+        return;
+    }
+    if (inputFileArg.values().size() != 1) {
+        cerr << Phrases::Error << "Generating info for multiple files requires an output directory (--output-dir)." << Phrases::EndFlush;
+        exit(-1);
+    }
     try {
         // parse tags
         MediaFileInfo inputFileInfo(inputFileArg.values().front());
@@ -130,7 +284,9 @@ void generateFileInfo(const ArgumentOccurrence &, const Argument &inputFileArg,
 #else
     CPP_UTILITIES_UNUSED(inputFileArg);
     CPP_UTILITIES_UNUSED(outputFileArg);
+    CPP_UTILITIES_UNUSED(outputDirArg);
     CPP_UTILITIES_UNUSED(validateArg);
+    CPP_UTILITIES_UNUSED(jobsArg);
     cerr << Phrases::Error << "Generating HTML info is only available if built with Qt support." << Phrases::EndFlush;
 #endif
 }
@@ -315,7 +471,94 @@ void displayFileInfo(const ArgumentOccurrence &, const Argument &filesArg, const
     }
 }
 
-void displayTagInfo(const Argument &fieldsArg, const Argument &showUnsupportedArg, const Argument &filesArg, const Argument &verboseArg)
+/*!
+ * \brief Prints the specified \a fields of the specified \a files as table with one row per file.
+ * \remarks If a field is present in multiple tags, the values of the first tag providing values are used. Multiple
+ *          values of a field are separated by semicolons.
+ */
+static void displayTagInfoAsTable(const FieldDenotations &fields, const vector<const char *> &files, OutputFormat format)
+{
+    // determine columns (in the specified order or all known fields if none specified)
+    vector<FieldScope> columns;
+    if (fields.empty()) {
+        for (auto field = firstKnownField; field != KnownField::Invalid; field = nextKnownField(field)) {
+            columns.emplace_back(field);
+        }
+    } else {
+        columns.resize(fields.size());
+        for (const auto &fieldDenotation : fields) {
+            columns[fieldDenotation.second.index] = fieldDenotation.first;
+        }
+    }
+
+    // write header
+    TableWriter writer(cout, format);
+    writer.addCell("file", 4);
+    for (const auto &column : columns) {
+        const auto knownField = column.field.knownField();
+        const char *name = knownField != KnownField::Invalid ? FieldMapping::fieldDenotation(knownField) : nullptr;
+        if (!name) {
+            name = column.field.name();
+        }
+        writer.addCell(name, strlen(name));
+    }
+    writer.endRow();
+
+    // write one row per file
+    MediaFileInfo fileInfo;
+    Diagnostics diag;
+    vector<Tag *> tags;
+    string cell;
+    for (const char *file : files) {
+        diag.clear();
+        tags.clear();
+        try {
+            fileInfo.setPath(file);
+            fileInfo.open(true);
+            fileInfo.parseContainerFormat(diag);
+            fileInfo.parseTags(diag);
+            fileInfo.tags(tags);
+        } catch (const TagParser::Failure &) {
+            cerr << Phrases::Error << "A parsing failure occured when reading the file \"" << file << "\"." << Phrases::EndFlush;
+        } catch (const std::ios_base::failure &) {
+            cerr << Phrases::Error << "An IO failure occured when reading the file \"" << file << "\"." << Phrases::EndFlush;
+        }
+        writer.addCell(file, strlen(file));
+        for (const auto &column : columns) {
+            cell.clear();
+            for (const auto *tag : tags) {
+                const auto tagType = tag->type();
+                if (!(column.tagType == TagType::Unspecified || (column.tagType & tagType))) {
+                    continue;
+                }
+                try {
+                    const auto values = column.field.values(tag, tagType);
+                    if (!values.second || values.first.empty()) {
+                        continue;
+                    }
+                    for (const auto *value : values.first) {
+                        try {
+                            if (!cell.empty()) {
+                                cell += ';';
+                            }
+                            cell += value->toString(TagTextEncoding::Utf8);
+                        } catch (const ConversionException &) {
+                            // skip values which can not be displayed as string (eg. covers)
+                        }
+                    }
+                    break;
+                } catch (const ConversionException &) {
+                    continue;
+                }
+            }
+            writer.addCell(cell);
+        }
+        writer.endRow();
+    }
+}
+
+void displayTagInfo(const Argument &fieldsArg, const Argument &showUnsupportedArg, const Argument &filesArg, const Argument &verboseArg,
+    const Argument &formatArg)
 {
     CMD_UTILS_START_CONSOLE;
 
@@ -328,6 +571,13 @@ void displayTagInfo(const Argument &fieldsArg, const Argument &showUnsupportedAr
     // parse specified fields
     const auto fields = parseFieldDenotations(fieldsArg, true);
 
+    // print as table if a tabular format has been specified
+    const auto format = parseOutputFormat(formatArg, OutputFormat::Human);
+    if (format != OutputFormat::Human) {
+        displayTagInfoAsTable(fields, filesArg.values(), format);
+        return;
+    }
+
     MediaFileInfo fileInfo;
     for (const char *file : filesArg.values()) {
         Diagnostics diag;
@@ -498,9 +748,10 @@ void setTagInfo(const SetTagInfoArgs &args)
         fileInfo.setBackupDirectory(args.backupDirArg.values().front());
     }
 
-    // iterate through all specified files
+    // iterate through all specified files (keeping the buffer for converted values to avoid re-allocating it for each field)
     unsigned int fileIndex = 0;
     static string context("setting tags");
+    vector<TagValue> convertedValues;
     for (const char *file : args.filesArg.values()) {
         Diagnostics diag;
         try {
@@ -598,7 +849,7 @@ void setTagInfo(const SetTagInfoArgs &args)
                             continue;
                         }
                         // convert the values to TagValue
-                        vector<TagValue> convertedValues;
+                        convertedValues.clear();
                         for (const FieldValue *relevantDenotedValue : fieldDenotation.second.relevantValues) {
                             // assign an empty TagValue to remove the field if denoted value is empty
                             if (relevantDenotedValue->value.empty()) {
@@ -740,7 +991,16 @@ void setTagInfo(const SetTagInfoArgs &args)
             fileInfo.setSaveFilePath(currentOutputFile != noMoreOutputFiles ? string(*currentOutputFile) : string());
             try {
                 // create handler for progress updates and aborting
-                AbortableProgressFeedback progress(logNextStep, logStepPercentage);
+                IoThrottle throttle(fileInfo.size());
+                AbortableProgressFeedback progress(
+                    [&throttle](AbortableProgressFeedback &progress) {
+                        throttle.nextStep();
+                        logNextStep(progress);
+                    },
+                    [&throttle](AbortableProgressFeedback &progress) {
+                        logStepPercentage(progress);
+                        throttle.throttle(progress);
+                    });
                 const InterruptHandler handler(bind(&AbortableProgressFeedback::tryToAbort, ref(progress)));
 
                 // apply changes
@@ -921,7 +1181,8 @@ void extractField(
     }
 }
 
-void exportToJson(const ArgumentOccurrence &, const Argument &filesArg, const Argument &prettyArg)
+void exportToJson(
+    const ArgumentOccurrence &, const Argument &filesArg, const Argument &prettyArg, const Argument &sinceArg, const Argument &formatArg)
 {
     CMD_UTILS_START_CONSOLE;
 
@@ -932,12 +1193,68 @@ void exportToJson(const ArgumentOccurrence &, const Argument &filesArg, const Ar
         exit(-1);
     }
 
+    // determine the encoding
+    auto cbor = false;
+    if (formatArg.isPresent()) {
+        const char *const format = formatArg.values().front();
+        if (!strcmp(format, "cbor")) {
+            cbor = true;
+        } else if (strcmp(format, "json")) {
+            cerr << Phrases::Error << "The specified export format \"" << format << "\" is invalid." << Phrases::End
+                 << "note: Valid formats are json and cbor." << endl;
+            exit(-1);
+        }
+    }
+    if (cbor && prettyArg.isPresent()) {
+        cerr << Phrases::Error << "The option --pretty can not be combined with the format cbor." << Phrases::End;
+        exit(-1);
+    }
+
+    // determine files which have changed since the specified snapshot
+    const auto &files = filesArg.values();
+    const char *const snapshotPath = sinceArg.isPresent() ? sinceArg.values().front() : nullptr;
+    FileSnapshot previousSnapshot, currentSnapshot;
+    if (snapshotPath) {
+        try {
+            previousSnapshot.load(snapshotPath);
+        } catch (const std::ios_base::failure &) {
+            cerr << Phrases::Error << "An IO failure occured when reading the snapshot \"" << snapshotPath << "\"." << Phrases::EndFlush;
+            exit(-1);
+        }
+        vector<const char *> inaccessibleFiles;
+        currentSnapshot = FileSnapshot::fromFiles(files, &inaccessibleFiles);
+        for (const char *file : inaccessibleFiles) {
+            cerr << Phrases::Error << "Unable to determine whether the file \"" << file << "\" has changed." << Phrases::EndFlush;
+        }
+    }
+
     RAPIDJSON_NAMESPACE::Document document(RAPIDJSON_NAMESPACE::kArrayType);
     std::vector<Json::FileInfo> jsonData;
+    Json::FileInfoDelta jsonDelta;
     MediaFileInfo fileInfo;
+    if (!snapshotPath && !cbor) {
+        jsonData.reserve(files.size());
+    }
+
+    // encode CBOR while gathering the tags so only the data of one file needs to be held in memory at a time
+    Json::RawBinaryData rawBinaryData;
+    unique_ptr<Cbor::Writer> cborWriter;
+    if (cbor) {
+        cborWriter = make_unique<Cbor::Writer>(cout, &rawBinaryData);
+        if (snapshotPath) {
+            cborWriter->StartObject();
+            cborWriter->Key("changed", 7, false);
+            cborWriter->StartObject();
+        } else {
+            cborWriter->StartArray();
+        }
+    }
 
     // gather tags for each file
-    for (const char *file : filesArg.values()) {
+    for (const char *file : files) {
+        if (snapshotPath && !currentSnapshot.hasChanged(file, previousSnapshot)) {
+            continue;
+        }
         Diagnostics diag;
         try {
             // parse tags
@@ -946,37 +1263,1058 @@ void exportToJson(const ArgumentOccurrence &, const Argument &filesArg, const Ar
             fileInfo.parseContainerFormat(diag);
             fileInfo.parseTags(diag);
             fileInfo.parseTracks(diag);
-            jsonData.emplace_back(fileInfo, document.GetAllocator());
+            if (cborWriter) {
+                {
+                    RAPIDJSON_NAMESPACE::Value value;
+                    ReflectiveRapidJSON::JsonReflector::push(
+                        Json::FileInfo(fileInfo, document.GetAllocator(), &rawBinaryData), value, document.GetAllocator());
+                    if (snapshotPath) {
+                        cborWriter->Key(file, static_cast<RAPIDJSON_NAMESPACE::SizeType>(strlen(file)), false);
+                    }
+                    value.Accept(*cborWriter);
+                }
+                document.GetAllocator().Clear();
+                rawBinaryData.clear();
+            } else if (snapshotPath) {
+                jsonDelta.changed.emplace(piecewise_construct, forward_as_tuple(file), forward_as_tuple(fileInfo, document.GetAllocator()));
+            } else {
+                jsonData.emplace_back(fileInfo, document.GetAllocator());
+            }
+            continue;
         } catch (const TagParser::Failure &) {
             cerr << Phrases::Error << "A parsing failure occured when reading the file \"" << file << "\"." << Phrases::EndFlush;
         } catch (const std::ios_base::failure &) {
             cerr << Phrases::Error << "An IO failure occured when reading the file \"" << file << "\"." << Phrases::EndFlush;
         }
+        // ensure the file is considered again by the next run (without reporting it as removed)
+        if (snapshotPath) {
+            currentSnapshot.markFailed(file);
+        }
     }
 
     // TODO: serialize diag messages
 
-    // print the gathered data as JSON document
-    ReflectiveRapidJSON::JsonReflector::push(jsonData, document, document.GetAllocator());
-    RAPIDJSON_NAMESPACE::OStreamWrapper osw(cout);
-    if (prettyArg.isPresent()) {
-        RAPIDJSON_NAMESPACE::PrettyWriter<RAPIDJSON_NAMESPACE::OStreamWrapper> writer(osw);
-        document.Accept(writer);
+    if (cborWriter) {
+        // finish CBOR output
+        if (snapshotPath) {
+            cborWriter->EndObject();
+            cborWriter->Key("removed", 7, false);
+            cborWriter->StartArray();
+            for (const auto &removedPath : currentSnapshot.takeOverUnspecified(previousSnapshot)) {
+                cborWriter->String(removedPath.data(), static_cast<RAPIDJSON_NAMESPACE::SizeType>(removedPath.size()), false);
+            }
+            cborWriter->EndArray();
+            cborWriter->EndObject();
+        } else {
+            cborWriter->EndArray();
+        }
+        cborWriter->flush();
     } else {
-        RAPIDJSON_NAMESPACE::Writer<RAPIDJSON_NAMESPACE::OStreamWrapper> writer(osw);
-        document.Accept(writer);
+        // print the gathered data as JSON document
+        if (snapshotPath) {
+            jsonDelta.removed = currentSnapshot.takeOverUnspecified(previousSnapshot);
+            document.SetObject();
+            ReflectiveRapidJSON::JsonReflector::push(jsonDelta, document, document.GetAllocator());
+        } else {
+            ReflectiveRapidJSON::JsonReflector::push(jsonData, document, document.GetAllocator());
+        }
+        RAPIDJSON_NAMESPACE::OStreamWrapper osw(cout);
+        if (prettyArg.isPresent()) {
+            RAPIDJSON_NAMESPACE::PrettyWriter<RAPIDJSON_NAMESPACE::OStreamWrapper> writer(osw);
+            document.Accept(writer);
+        } else {
+            RAPIDJSON_NAMESPACE::Writer<RAPIDJSON_NAMESPACE::OStreamWrapper> writer(osw);
+            document.Accept(writer);
+        }
+        cout << endl;
+    }
+
+    // update the snapshot for the next run
+    if (snapshotPath) {
+        try {
+            currentSnapshot.save(snapshotPath);
+        } catch (const std::ios_base::failure &) {
+            cerr << Phrases::Error << "An IO failure occured when writing the snapshot \"" << snapshotPath << "\"." << Phrases::EndFlush;
+        }
     }
-    cout << endl;
 
 #else
     CPP_UTILITIES_UNUSED(filesArg);
     CPP_UTILITIES_UNUSED(prettyArg);
+    CPP_UTILITIES_UNUSED(sinceArg);
+    CPP_UTILITIES_UNUSED(formatArg);
     cerr << Phrases::Error << "JSON export has not been enabled when building the tag editor." << Phrases::EndFlush;
 #endif
 }
 
-void applyGeneralConfig(const Argument &timeSapnFormatArg)
+#ifdef TAGEDITOR_JSON_EXPORT
+/*!
+ * \brief Converts the specified \a value object (as created by Json::TagValue) back to a TagParser::TagValue.
+ * \returns Returns whether the value could be converted; empty and erroneous values are skipped.
+ */
+static bool importTagValue(const RAPIDJSON_NAMESPACE::Value &value, TagTextEncoding encoding, TagValue &tagValue)
+{
+    if (!value.IsObject()) {
+        return false;
+    }
+    const auto kindMember = value.FindMember("kind"), valueMember = value.FindMember("value");
+    if (kindMember == value.MemberEnd() || valueMember == value.MemberEnd() || !kindMember->value.IsString()) {
+        return false;
+    }
+    const char *const kind = kindMember->value.GetString();
+    const auto &data = valueMember->value;
+    if (!strcmp(kind, "integer") && data.IsInt()) {
+        tagValue.assignInteger(data.GetInt());
+    } else if (!strcmp(kind, "position") && data.IsObject()) {
+        const auto position = data.FindMember("position"), total = data.FindMember("total");
+        tagValue.assignPosition(PositionInSet(position != data.MemberEnd() && position->value.IsInt() ? position->value.GetInt() : 0,
+            total != data.MemberEnd() && total->value.IsInt() ? total->value.GetInt() : 0));
+    } else if ((!strcmp(kind, "picture") || !strcmp(kind, "binary")) && data.IsString()) {
+        const auto decoded = decodeBase64(data.GetString(), data.GetStringLength());
+        tagValue.assignData(reinterpret_cast<const char *>(decoded.first.get()), decoded.second,
+            !strcmp(kind, "picture") ? TagDataType::Picture : TagDataType::Binary);
+        const auto mimeType = value.FindMember("mimeType");
+        if (mimeType != value.MemberEnd() && mimeType->value.IsString()) {
+            tagValue.setMimeType(mimeType->value.GetString());
+        }
+    } else if (strcmp(kind, "error") && data.IsString()) {
+        // treat text and values of kinds not specifically handled (eg. time spans and dates) as text
+        tagValue.assignText(data.GetString(), data.GetStringLength(), TagTextEncoding::Utf8, encoding);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Returns whether the specified \a value object (as created by Json::TagValue) represents an empty value.
+ */
+static bool isEmptyTagValue(const RAPIDJSON_NAMESPACE::Value &value)
+{
+    if (!value.IsObject()) {
+        return value.IsNull();
+    }
+    const auto valueMember = value.FindMember("value");
+    return valueMember == value.MemberEnd() || valueMember->value.IsNull();
+}
+
+/*!
+ * \brief Converts the specified \a target object (as created by Json::TargetInfo) back to a TagParser::TagTarget.
+ */
+static TagTarget importTagTarget(const RAPIDJSON_NAMESPACE::Value &target)
+{
+    TagTarget tagTarget;
+    if (!target.IsObject()) {
+        return tagTarget;
+    }
+    const auto level = target.FindMember("level"), levelName = target.FindMember("levelName");
+    if (level != target.MemberEnd() && level->value.IsUint64()) {
+        tagTarget.setLevel(level->value.GetUint64());
+    }
+    if (levelName != target.MemberEnd() && levelName->value.IsString()) {
+        tagTarget.setLevelName(levelName->value.GetString());
+    }
+    const auto importIds = [&target](const char *name, TagTarget::IdContainerType &ids) {
+        const auto member = target.FindMember(name);
+        if (member == target.MemberEnd() || !member->value.IsArray()) {
+            return;
+        }
+        for (const auto &id : member->value.GetArray()) {
+            if (id.IsUint64()) {
+                ids.emplace_back(id.GetUint64());
+            }
+        }
+    };
+    importIds("tracks", tagTarget.tracks());
+    importIds("chapters", tagTarget.chapters());
+    importIds("editions", tagTarget.editions());
+    importIds("attachments", tagTarget.attachments());
+    return tagTarget;
+}
+
+/*!
+ * \brief Applies the tags described by the specified \a fileObject (as created by Json::FileInfo) to the file at \a path.
+ * \remarks Only the specified fields are altered. Specifying an empty array for a field removes it. Fields with values which
+ *          can not be imported (eg. values of the kind "error") are left untouched; empty values are skipped.
+ */
+static void importFile(const char *path, const RAPIDJSON_NAMESPACE::Value &fileObject, MediaFileInfo &fileInfo, Diagnostics &diag)
+{
+    static const string context("importing tags");
+    if (!fileObject.IsObject() || !fileObject.HasMember("tags") || !fileObject["tags"].IsArray()) {
+        diag.emplace_back(DiagLevel::Critical, "The document contains no tags for the file.", context);
+        return;
+    }
+    const auto tagObjects = fileObject["tags"].GetArray();
+
+    // parse the file and create tags for all targets of the document
+    fileInfo.setPath(path);
+    fileInfo.parseContainerFormat(diag);
+    fileInfo.parseTags(diag);
+    fileInfo.parseTracks(diag);
+    TagCreationSettings settings;
+    settings.flags = TagCreationFlags::KeepExistingId3v2Version;
+    vector<TagTarget> targets;
+    targets.reserve(tagObjects.Size());
+    for (const auto &tagObject : tagObjects) {
+        targets.emplace_back(tagObject.IsObject() && tagObject.HasMember("target") ? importTagTarget(tagObject["target"]) : TagTarget());
+        if (find(settings.requiredTargets.cbegin(), settings.requiredTargets.cend(), targets.back()) == settings.requiredTargets.cend()) {
+            settings.requiredTargets.emplace_back(targets.back());
+        }
+    }
+    fileInfo.createAppropriateTags(settings);
+
+    // assign the values of each tag object to the tags of the same format and target
+    vector<TagValue> values;
+    for (auto *tag : fileInfo.tags()) {
+        const auto encoding = tag->canEncodingBeUsed(TagTextEncoding::Utf8) ? TagTextEncoding::Utf8 : tag->proposedTextEncoding();
+        auto target = targets.cbegin();
+        for (const auto &tagObject : tagObjects) {
+            const auto &tagTarget = *target++;
+            if (!tagObject.IsObject() || (tag->supportsTarget() && !(tag->target() == tagTarget))) {
+                continue;
+            }
+            const auto format = tagObject.FindMember("format"), fields = tagObject.FindMember("fields");
+            if (format == tagObject.MemberEnd() || !format->value.IsString() || strcmp(format->value.GetString(), tag->typeName())
+                || fields == tagObject.MemberEnd() || !fields->value.IsObject()) {
+                continue;
+            }
+            for (const auto &field : fields->value.GetObject()) {
+                const auto knownField = FieldMapping::knownField(field.name.GetString(), field.name.GetStringLength());
+                if (knownField == KnownField::Invalid || !field.value.IsArray()) {
+                    diag.emplace_back(
+                        DiagLevel::Warning, argsToString("Ignoring unknown field \"", field.name.GetString(), "\" in ", tagName(tag), '.'), context);
+                    continue;
+                }
+                // keep the existing values if any of the specified values can not be imported (eg. a cover exported as error)
+                // so values are never lost; empty values (exported as null) are just skipped
+                values.clear();
+                const auto valueObjects = field.value.GetArray();
+                auto importable = true;
+                for (const auto &valueObject : valueObjects) {
+                    TagValue value;
+                    if (importTagValue(valueObject, encoding, value)) {
+                        values.emplace_back(move(value));
+                    } else if (!isEmptyTagValue(valueObject)) {
+                        importable = false;
+                    }
+                }
+                if (!importable) {
+                    diag.emplace_back(DiagLevel::Warning,
+                        argsToString("Leaving field \"", field.name.GetString(), "\" in ", tagName(tag),
+                            " untouched because not all of its values can be imported."),
+                        context);
+                } else if (valueObjects.Empty() || !values.empty()) {
+                    tag->setValues(knownField, values);
+                }
+            }
+        }
+    }
+
+    // apply changes (without progress output since multiple files are processed at the same time)
+    applyChangesWithIoRateLimit(fileInfo, diag);
+}
+#endif
+
+void importFromJson(const ArgumentOccurrence &, const Argument &inputFileArg, const Argument &filesArg, const Argument &jobsArg,
+    const Argument &verboseArg)
+{
+    CMD_UTILS_START_CONSOLE;
+
+#ifdef TAGEDITOR_JSON_EXPORT
+    // read document
+    const char *const inputFile = inputFileArg.values().front();
+    RAPIDJSON_NAMESPACE::Document document;
+    try {
+        NativeFileStream inputStream;
+        inputStream.exceptions(ios_base::badbit);
+        inputStream.open(inputFile, ios_base::in | ios_base::binary);
+        if (!inputStream.is_open()) {
+            throw std::ios_base::failure("unable to open file");
+        }
+        RAPIDJSON_NAMESPACE::IStreamWrapper inputStreamWrapper(inputStream);
+        document.ParseStream(inputStreamWrapper);
+    } catch (const std::ios_base::failure &) {
+        cerr << Phrases::Error << "An IO failure occured when reading the file \"" << inputFile << "\"." << Phrases::EndFlush;
+        exit(-1);
+    }
+    if (document.HasParseError()) {
+        cerr << Phrases::Error << "The file \"" << inputFile
+             << "\" is no valid JSON document: " << RAPIDJSON_NAMESPACE::GetParseError_En(document.GetParseError()) << " (at offset "
+             << document.GetErrorOffset() << ')' << Phrases::EndFlush;
+        exit(-1);
+    }
+
+    // determine the files to be modified; an array of files needs to be accompanied by the corresponding paths
+    // (as only the file name is exported) and an export created via --since contains the paths already
+    vector<pair<const char *, const RAPIDJSON_NAMESPACE::Value *>> files;
+    if (document.IsArray()) {
+        const auto fileObjects = document.GetArray();
+        if (!filesArg.isPresent() || filesArg.values().size() != fileObjects.Size()) {
+            cerr << Phrases::Error << "The number of specified files does not match the number of files within the document." << Phrases::EndFlush;
+            exit(-1);
+        }
+        files.reserve(fileObjects.Size());
+        auto path = filesArg.values().cbegin();
+        for (const auto &fileObject : fileObjects) {
+            files.emplace_back(*path++, &fileObject);
+        }
+    } else if (document.IsObject() && document.HasMember("changed") && document["changed"].IsObject()) {
+        if (filesArg.isPresent()) {
+            cerr << Phrases::Error << "Files must not be specified when importing a document containing paths." << Phrases::EndFlush;
+            exit(-1);
+        }
+        for (const auto &fileObject : document["changed"].GetObject()) {
+            files.emplace_back(fileObject.name.GetString(), &fileObject.value);
+        }
+    } else {
+        cerr << Phrases::Error << "The file \"" << inputFile << "\" does not contain an export of the tag editor." << Phrases::EndFlush;
+        exit(-1);
+    }
+
+    // stop processing further files when interrupted (files being written are completed)
+    atomic<bool> aborted(false);
+    const InterruptHandler handler([&aborted] { aborted = true; });
+
+    // import files in parallel
+    mutex outputMutex;
+    runInParallel(
+        files.size(),
+        [&](size_t index) {
+            if (aborted) {
+                return;
+            }
+            const char *const path = files[index].first;
+            MediaFileInfo fileInfo;
+            fileInfo.setWritingApplication(APP_NAME " v" APP_VERSION);
+            Diagnostics diag;
+            const char *failure = nullptr;
+            try {
+                importFile(path, *files[index].second, fileInfo, diag);
+            } catch (const TagParser::Failure &) {
+                failure = "A parsing failure occured when reading/writing the file";
+            } catch (const std::ios_base::failure &) {
+                failure = "An IO failure occured when reading/writing the file";
+            }
+            const lock_guard<mutex> outputLock(outputMutex);
+            cout << TextAttribute::Bold << "Importing tag information for \"" << path << "\" ..." << Phrases::EndFlush;
+            if (failure) {
+                cerr << " - " << Phrases::Error << failure << " \"" << path << "\"." << Phrases::EndFlush;
+            } else {
+                cout << " - Changes have been applied." << endl;
+            }
+            printDiagMessages(diag, "Diagnostic messages:", verboseArg.isPresent());
+        },
+        static_cast<unsigned int>(parseUInt64(jobsArg, 0)));
+    if (aborted) {
+        cerr << Phrases::Warning << "The operation has been aborted." << Phrases::EndFlush;
+    }
+
+#else
+    CPP_UTILITIES_UNUSED(inputFileArg);
+    CPP_UTILITIES_UNUSED(filesArg);
+    CPP_UTILITIES_UNUSED(jobsArg);
+    CPP_UTILITIES_UNUSED(verboseArg);
+    cerr << Phrases::Error << "JSON import has not been enabled when building the tag editor." << Phrases::EndFlush;
+#endif
+}
+
+/*!
+ * \brief The ValidationResult struct holds the result of validating a single file.
+ */
+struct ValidationResult {
+    bool validated = false;
+    DiagLevel level = DiagLevel::None;
+    size_t criticalCount = 0;
+    size_t warningCount = 0;
+    Diagnostics messages;
+};
+
+/*!
+ * \brief Writes the specified \a value as JSON string.
+ */
+static void writeJsonString(ostream &stream, const string &value)
+{
+    stream << '\"';
+    for (const char c : value) {
+        switch (c) {
+        case '\"':
+            stream << "\\\"";
+            break;
+        case '\\':
+            stream << "\\\\";
+            break;
+        case '\n':
+            stream << "\\n";
+            break;
+        case '\r':
+            stream << "\\r";
+            break;
+        case '\t':
+            stream << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                stream << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF] << "0123456789abcdef"[c & 0xF];
+            } else {
+                stream << c;
+            }
+        }
+    }
+    stream << '\"';
+}
+
+void validateFiles(const ArgumentOccurrence &, const Argument &filesArg, const Argument &jobsArg, const Argument &formatArg, const Argument &verboseArg)
+{
+    CMD_UTILS_START_CONSOLE;
+
+    // check whether files have been specified
+    if (!filesArg.isPresent() || filesArg.values().empty()) {
+        cerr << Phrases::Error << "No files have been specified." << Phrases::End;
+        exit(-1);
+    }
+    const auto json = formatArg.isPresent() && !strcmp(formatArg.values().front(), "json");
+    const auto format = json ? OutputFormat::Human : parseOutputFormat(formatArg, OutputFormat::Human);
+    const auto verbose = verboseArg.isPresent();
+
+    // stop processing further files when interrupted
+    atomic<bool> aborted(false);
+    const InterruptHandler handler([&aborted] { aborted = true; });
+
+    // parse the files completely in parallel; only keep messages which are relevant for the report
+    const auto &files = filesArg.values();
+    vector<ValidationResult> results(files.size());
+    runInParallel(
+        files.size(),
+        [&](size_t index) {
+            if (aborted) {
+                return;
+            }
+            auto &result = results[index];
+            Diagnostics diag;
+            try {
+                MediaFileInfo fileInfo(files[index]);
+                fileInfo.setForceFullParse(true);
+                fileInfo.open(true);
+                fileInfo.parseEverything(diag);
+            } catch (const TagParser::Failure &) {
+                diag.emplace_back(DiagLevel::Fatal, "A parsing failure occured when reading the file.", "validating file");
+            } catch (const std::ios_base::failure &) {
+                diag.emplace_back(DiagLevel::Fatal, "An IO failure occured when reading the file.", "validating file");
+            }
+            result.validated = true;
+            for (auto &message : diag) {
+                if (message.level() > result.level) {
+                    result.level = message.level();
+                }
+                switch (message.level()) {
+                case DiagLevel::Warning:
+                    ++result.warningCount;
+                    break;
+                case DiagLevel::Critical:
+                case DiagLevel::Fatal:
+                    ++result.criticalCount;
+                    break;
+                default:
+                    if (!verbose) {
+                        continue;
+                    }
+                }
+                result.messages.emplace_back(move(message));
+            }
+        },
+        static_cast<unsigned int>(parseUInt64(jobsArg, 0)));
+
+    // write report; files without issues are only listed when being verbose
+    const auto isListed = [verbose](const ValidationResult &result) { return result.validated && (verbose || result.level >= DiagLevel::Warning); };
+    if (json) {
+        cout << '[';
+        auto firstFile = true;
+        for (size_t index = 0; index != files.size(); ++index) {
+            const auto &result = results[index];
+            if (!isListed(result)) {
+                continue;
+            }
+            cout << (firstFile ? "{\"path\":" : ",{\"path\":");
+            firstFile = false;
+            writeJsonString(cout, files[index]);
+            cout << ",\"level\":\"" << diagLevelName(result.level) << "\",\"critical\":" << result.criticalCount
+                 << ",\"warnings\":" << result.warningCount << ",\"messages\":[";
+            for (auto message = result.messages.cbegin(); message != result.messages.cend(); ++message) {
+                cout << (message == result.messages.cbegin() ? "{\"level\":\"" : ",{\"level\":\"") << diagLevelName(message->level())
+                     << "\",\"context\":";
+                writeJsonString(cout, message->context());
+                cout << ",\"message\":";
+                writeJsonString(cout, message->message());
+                cout << '}';
+            }
+            cout << "]}";
+        }
+        cout << "]\n";
+    } else if (format == OutputFormat::Human) {
+        for (size_t index = 0; index != files.size(); ++index) {
+            if (isListed(results[index])) {
+                cout << TextAttribute::Bold << "Validation of \"" << files[index] << "\":" << Phrases::EndFlush;
+                if (results[index].messages.empty()) {
+                    cout << " - No issues found." << endl;
+                } else {
+                    printDiagMessages(results[index].messages, nullptr, verbose);
+                }
+            }
+        }
+    } else {
+        TableWriter table(cout, format);
+        for (const char *const header : { "path", "level", "critical", "warnings", "message" }) {
+            table.addCell(header, strlen(header));
+        }
+        table.endRow();
+        for (size_t index = 0; index != files.size(); ++index) {
+            const auto &result = results[index];
+            if (!isListed(result)) {
+                continue;
+            }
+            table.addCell(files[index], strlen(files[index]));
+            table.addCell(diagLevelName(result.level), strlen(diagLevelName(result.level)));
+            table.addCell(numberToString(result.criticalCount));
+            table.addCell(numberToString(result.warningCount));
+            // show the first of the most severe messages
+            const auto mostSevere = max_element(result.messages.cbegin(), result.messages.cend(),
+                [](const DiagMessage &lhs, const DiagMessage &rhs) { return lhs.level() < rhs.level(); });
+            table.addCell(mostSevere != result.messages.cend() ? mostSevere->context() % ": " + mostSevere->message() : string());
+            table.endRow();
+        }
+    }
+
+    // print summary (to stderr when the report is supposed to be processed by other tools)
+    size_t validatedFiles = 0, criticalFiles = 0, warningFiles = 0;
+    for (const auto &result : results) {
+        validatedFiles += result.validated;
+        if (result.level >= DiagLevel::Critical) {
+            ++criticalFiles;
+        } else if (result.level == DiagLevel::Warning) {
+            ++warningFiles;
+        }
+    }
+    (format == OutputFormat::Human && !json ? cout : cerr)
+        << "Validated " << validatedFiles << " file(s): " << criticalFiles << " with critical issues, " << warningFiles << " with warnings, "
+        << (validatedFiles - criticalFiles - warningFiles) << " without issues." << endl;
+    if (aborted) {
+        cerr << Phrases::Warning << "The operation has been aborted." << Phrases::EndFlush;
+    }
+    if (criticalFiles) {
+        exit(1);
+    }
+}
+
+#if defined(TAGEDITOR_GUI_QTWIDGETS) || defined(TAGEDITOR_GUI_QTQUICK)
+/*!
+ * \brief The CoverNormalization struct specifies how covers are supposed to be re-encoded.
+ */
+struct CoverNormalization {
+    int maxSize;
+    const char *format;
+    const char *mimeType;
+    int quality;
+};
+
+/*!
+ * \brief Downsizes and re-encodes the picture stored in \a value according to the specified \a settings.
+ * \remarks Only pictures exceeding the maximum size or not stored as JPEG or PNG are re-encoded. Other pictures are
+ *          kept as-is to avoid the quality loss of re-encoding them (eg. from PNG to JPEG or from JPEG to JPEG).
+ * \returns Returns the number of bytes saved; the value is only modified if the re-encoded picture is actually smaller.
+ */
+static size_t normalizePicture(TagValue &value, const CoverNormalization &settings)
+{
+    if (value.isEmpty() || value.mimeType() == "-->" || value.dataSize() >= static_cast<size_t>(numeric_limits<int>::max())) {
+        return 0;
+    }
+    auto originalData = QByteArray::fromRawData(value.dataPointer(), static_cast<int>(value.dataSize()));
+    QBuffer originalBuffer(&originalData);
+    QImageReader reader(&originalBuffer);
+    const auto originalFormat = reader.format();
+    const auto originalSize = reader.size();
+    const auto exceedsMaxSize = !originalSize.isValid() || originalSize.width() > settings.maxSize || originalSize.height() > settings.maxSize;
+    if (!exceedsMaxSize && (originalFormat == "jpeg" || originalFormat == "png")) {
+        return 0;
+    }
+    auto image = reader.read();
+    if (image.isNull()) {
+        return 0;
+    }
+    if (image.width() > settings.maxSize || image.height() > settings.maxSize) {
+        image = image.scaled(settings.maxSize, settings.maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    if (image.hasAlphaChannel() && !strcmp(settings.format, "JPEG")) {
+        // JPEG has no alpha channel; blend onto white instead of letting transparent areas turn black
+        QImage opaqueImage(image.size(), QImage::Format_RGB32);
+        opaqueImage.fill(Qt::white);
+        QPainter(&opaqueImage).drawImage(0, 0, image);
+        image = move(opaqueImage);
+    }
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, settings.format, settings.quality) || static_cast<size_t>(data.size()) >= value.dataSize()) {
+        return 0;
+    }
+    const auto savedBytes = value.dataSize() - static_cast<size_t>(data.size());
+    value.assignData(data.data(), static_cast<size_t>(data.size()), TagDataType::Picture);
+    value.setMimeType(settings.mimeType);
+    return savedBytes;
+}
+
+/*!
+ * \brief Normalizes all covers of the specified \a tag.
+ * \remarks The fields are modified in-place so meta data like the picture type and description is preserved.
+ */
+template <class ConcreteTag> size_t normalizeCovers(Tag *tag, const CoverNormalization &settings)
+{
+    auto *const concreteTag = static_cast<ConcreteTag *>(tag);
+    const auto range = concreteTag->fields().equal_range(concreteTag->fieldId(KnownField::Cover));
+    size_t savedBytes = 0;
+    for (auto i = range.first; i != range.second; ++i) {
+        savedBytes += normalizePicture(i->second.value(), settings);
+    }
+    return savedBytes;
+}
+
+/*!
+ * \brief Normalizes all covers of the specified \a tag.
+ */
+static size_t normalizeCovers(Tag *tag, const CoverNormalization &settings)
+{
+    switch (tag->type()) {
+    case TagType::Id3v2Tag:
+        return normalizeCovers<Id3v2Tag>(tag, settings);
+    case TagType::Mp4Tag:
+        return normalizeCovers<Mp4Tag>(tag, settings);
+    case TagType::VorbisComment:
+    case TagType::OggVorbisComment:
+        return normalizeCovers<VorbisComment>(tag, settings);
+    default:
+        return 0;
+    }
+}
+#endif
+
+void normalizeCovers(const ArgumentOccurrence &, const Argument &filesArg, const Argument &maxSizeArg, const Argument &formatArg,
+    const Argument &qualityArg, const Argument &jobsArg, const Argument &verboseArg)
+{
+    CMD_UTILS_START_CONSOLE;
+
+#if defined(TAGEDITOR_GUI_QTWIDGETS) || defined(TAGEDITOR_GUI_QTQUICK)
+    // check whether files have been specified
+    if (!filesArg.isPresent() || filesArg.values().empty()) {
+        cerr << Phrases::Error << "No files have been specified." << Phrases::End;
+        exit(-1);
+    }
+
+    // determine settings
+    CoverNormalization settings{ 1000, "JPEG", "image/jpeg", 85 };
+    if (formatArg.isPresent()) {
+        const char *const format = formatArg.values().front();
+        if (!strcmp(format, "png")) {
+            settings.format = "PNG";
+            settings.mimeType = "image/png";
+        } else if (strcmp(format, "jpeg")) {
+            cerr << Phrases::Error << "The specified format \"" << format << "\" is invalid." << Phrases::End
+                 << "note: Valid formats are jpeg and png." << endl;
+            exit(-1);
+        }
+    }
+    const auto maxSize = parseUInt64(maxSizeArg, static_cast<uint64_t>(settings.maxSize));
+    const auto quality = parseUInt64(qualityArg, static_cast<uint64_t>(settings.quality));
+    if (!maxSize || maxSize > static_cast<uint64_t>(numeric_limits<int>::max())) {
+        cerr << Phrases::Error << "The specified maximum size is invalid." << Phrases::EndFlush;
+        exit(-1);
+    }
+    if (quality > 100) {
+        cerr << Phrases::Error << "The specified quality must be within 0 and 100." << Phrases::EndFlush;
+        exit(-1);
+    }
+    settings.maxSize = static_cast<int>(maxSize);
+    settings.quality = static_cast<int>(quality);
+
+    // stop processing further files when interrupted (files being written are completed)
+    atomic<bool> aborted(false);
+    const InterruptHandler handler([&aborted] { aborted = true; });
+
+    // process files in parallel; files are only written if at least one cover could be shrunk
+    const auto &files = filesArg.values();
+    atomic<uint64_t> totalSavedBytes(0);
+    mutex outputMutex;
+    runInParallel(
+        files.size(),
+        [&](size_t index) {
+            if (aborted) {
+                return;
+            }
+            const char *const path = files[index];
+            MediaFileInfo fileInfo(path);
+            fileInfo.setWritingApplication(APP_NAME " v" APP_VERSION);
+            Diagnostics diag;
+            const char *failure = nullptr;
+            size_t savedBytes = 0;
+            try {
+                fileInfo.open();
+                fileInfo.parseContainerFormat(diag);
+                fileInfo.parseTags(diag);
+                for (auto *const tag : fileInfo.tags()) {
+                    savedBytes += normalizeCovers(tag, settings);
+                }
+                if (savedBytes) {
+                    applyChangesWithIoRateLimit(fileInfo, diag);
+                }
+            } catch (const TagParser::Failure &) {
+                failure = "A parsing failure occured when reading/writing the file";
+            } catch (const std::ios_base::failure &) {
+                failure = "An IO failure occured when reading/writing the file";
+            }
+            if (!failure) {
+                totalSavedBytes += savedBytes;
+            }
+            const lock_guard<mutex> outputLock(outputMutex);
+            cout << TextAttribute::Bold << "Normalizing covers of \"" << path << "\" ..." << Phrases::EndFlush;
+            if (failure) {
+                cerr << " - " << Phrases::Error << failure << " \"" << path << "\"." << Phrases::EndFlush;
+            } else if (savedBytes) {
+                cout << " - Covers have been shrunk by " << dataSizeToString(savedBytes) << '.' << endl;
+            } else {
+                cout << " - No cover could be shrunk; the file has been left as-is." << endl;
+            }
+            printDiagMessages(diag, "Diagnostic messages:", verboseArg.isPresent());
+        },
+        static_cast<unsigned int>(parseUInt64(jobsArg, 0)));
+    cout << "Saved " << dataSizeToString(totalSavedBytes.load()) << " in total." << endl;
+    if (aborted) {
+        cerr << Phrases::Warning << "The operation has been aborted." << Phrases::EndFlush;
+    }
+
+#else
+    CPP_UTILITIES_UNUSED(filesArg);
+    CPP_UTILITIES_UNUSED(maxSizeArg);
+    CPP_UTILITIES_UNUSED(formatArg);
+    CPP_UTILITIES_UNUSED(qualityArg);
+    CPP_UTILITIES_UNUSED(jobsArg);
+    CPP_UTILITIES_UNUSED(verboseArg);
+    cerr << Phrases::Error << "Normalizing covers requires the tag editor to be built with Qt GUI support." << Phrases::EndFlush;
+#endif
+}
+
+/*!
+ * \brief The RenamingResult struct holds the path generated for a single file by the rename operation.
+ */
+struct RenamingResult {
+    bool evaluated = false;
+    std::filesystem::path target;
+    const char *failure = nullptr;
+    const char *skipReason = nullptr;
+};
+
+/*!
+ * \brief Renames the specified files according to the specified \a renamingTemplate.
+ * \remarks Does not depend on Qt; the files are parsed in parallel and renamed via a RenamingPlan afterwards.
+ * \remarks Unlike RenamingEngine::executeTemplateForItem(), generated paths are always relative to \a targetDir or, if not specified, to
+ *          the directory of each file, as there is no common root directory.
+ */
+static void renameFilesViaTemplate(const Argument &filesArg, const RenamingUtility::RenamingTemplate &renamingTemplate, const char *targetDir,
+    bool dryRun, const Argument &jobsArg, bool verbose)
+{
+    // stop processing further files when interrupted
+    atomic<bool> aborted(false);
+    const InterruptHandler handler([&aborted] { aborted = true; });
+
+    // parse the files and evaluate the template in parallel; only the container format and the tags are required
+    const auto &files = filesArg.values();
+    vector<RenamingResult> results(files.size());
+    runInParallel(
+        files.size(),
+        [&](size_t index) {
+            if (aborted) {
+                return;
+            }
+            auto &result = results[index];
+            Diagnostics diag;
+            try {
+                MediaFileInfo fileInfo(files[index]);
+                fileInfo.open(true);
+                fileInfo.parseContainerFormat(diag);
+                fileInfo.parseTags(diag);
+                if (fileInfo.containerFormat() == ContainerFormat::Unknown) {
+                    result.skipReason = "the format is not supported";
+                } else if (!fileInfo.hasAnyTag()) {
+                    result.skipReason = "the file has no tags";
+                } else if (const auto relativePath = renamingTemplate.evaluate(fileInfo); relativePath.empty()) {
+                    result.failure = "the template evaluates to an empty path";
+                } else {
+                    result.target = (targetDir ? std::filesystem::path(targetDir) : std::filesystem::path(files[index]).parent_path()) / relativePath;
+                }
+            } catch (const TagParser::Failure &) {
+                result.failure = "a parsing failure occured when reading the file";
+            } catch (const std::ios_base::failure &) {
+                result.failure = "an IO failure occured when reading the file";
+            }
+            result.evaluated = true;
+        },
+        static_cast<unsigned int>(parseUInt64(jobsArg, 0)));
+
+    // plan renames so conflicts (also between the files to be renamed) are detected before anything is renamed
+    RenamingUtility::RenamingPlan plan;
+    constexpr auto notPlanned = numeric_limits<size_t>::max();
+    vector<size_t> operations(files.size(), notPlanned);
+    size_t unchangedFiles = 0, skippedFiles = 0;
+    for (size_t index = 0; index != files.size(); ++index) {
+        const auto &result = results[index];
+        if (!result.evaluated || result.failure) {
+            continue;
+        }
+        if (result.skipReason) {
+            ++skippedFiles;
+            if (verbose) {
+                cout << " - \"" << files[index] << "\" has been skipped: " << result.skipReason << '.' << endl;
+            }
+            continue;
+        }
+        std::error_code error;
+        auto source = std::filesystem::absolute(files[index], error).lexically_normal();
+        auto target = std::filesystem::absolute(result.target, error).lexically_normal();
+        if (source == target) {
+            ++unchangedFiles;
+            if (verbose) {
+                cout << " - \"" << files[index] << "\" is already named correctly." << endl;
+            }
+            continue;
+        }
+        operations[index] = plan.addOperation(source.string(), target.string());
+    }
+    plan.prepare();
+
+    // rename files without overwriting existing files; revert all renames when interrupted
+    if (!dryRun && !aborted) {
+        const auto jobs = static_cast<unsigned int>(parseUInt64(jobsArg, 0));
+        plan.execute([jobs](size_t count, const function<void(size_t)> &function) { runInParallel(count, function, jobs); },
+            [&aborted] { return aborted.load(); });
+        if (aborted) {
+            plan.revert();
+        }
+    }
+
+    // print results
+    size_t renamedFiles = 0, failedFiles = 0;
+    for (size_t index = 0; index != files.size(); ++index) {
+        const auto &result = results[index];
+        const auto *const operation = operations[index] != notPlanned ? &plan.operations()[operations[index]] : nullptr;
+        const char *failure = result.failure;
+        if (operation) {
+            if (operation->status == RenamingUtility::RenamingStatus::Done
+                || (dryRun && operation->status == RenamingUtility::RenamingStatus::Pending)) {
+                ++renamedFiles;
+                cout << '\"' << files[index] << "\" -> \"" << operation->target << '\"' << endl;
+                continue;
+            }
+            failure = RenamingUtility::RenamingPlan::statusMessage(operation->status);
+        }
+        if (!failure) {
+            continue;
+        }
+        ++failedFiles;
+        cerr << Phrases::Error << "Unable to rename \"" << files[index] << '\"';
+        if (operation) {
+            cerr << " to \"" << operation->target << '\"';
+        }
+        cerr << ": " << failure;
+        if (operation && operation->errorNumber) {
+            cerr << " (" << strerror(operation->errorNumber) << ')';
+        }
+        cerr << '.' << Phrases::EndFlush;
+    }
+    cout << (dryRun ? "Would rename " : "Renamed ") << renamedFiles << " file(s), " << unchangedFiles << " unchanged, " << skippedFiles
+         << " skipped, " << failedFiles << " failed." << endl;
+    if (aborted) {
+        cerr << Phrases::Warning << "The operation has been aborted." << Phrases::EndFlush;
+    }
+    if (failedFiles) {
+        exit(1);
+    }
+}
+
+#if defined(TAGEDITOR_GUI_QTWIDGETS) && !defined(TAGEDITOR_NO_JSENGINE)
+/*!
+ * \brief The RenamingSummary struct counts the items listed by printRenamingChanges().
+ */
+struct RenamingSummary {
+    size_t renamed = 0;
+    size_t moved = 0;
+    size_t unchanged = 0;
+    size_t failed = 0;
+};
+
+/*!
+ * \brief Prints the changes of the children of the specified \a parentItem generated by the renaming engine as compact diff.
+ *
+ * Each line starts with "R" (renamed), "M" (moved) or "!" (error) followed by the path relative to the root directory
+ * and the new path or the error. Unchanged items are only listed when \a verbose is set.
+ */
+static void printRenamingChanges(const RenamingUtility::FileSystemItem *parentItem, bool verbose, RenamingSummary &summary)
+{
+    using namespace RenamingUtility;
+    for (const auto *const item : parentItem->children()) {
+        const auto *const newItem = item->counterpart();
+        if (item->status() == ItemStatus::New) {
+            // new items are listed via their counterpart; only list errors of directories which needed to be created
+            if (!newItem && item->errorOccured()) {
+                ++summary.failed;
+                cout << "! " << qPrintable(item->relativePath()) << ": " << qPrintable(item->note()) << '\n';
+            }
+        } else if (item->errorOccured()) {
+            ++summary.failed;
+            const auto &note = newItem && !newItem->note().isEmpty() ? newItem->note() : item->note();
+            cout << "! " << qPrintable(item->relativePath()) << ": " << qPrintable(note) << '\n';
+        } else if (newItem && (newItem->parent() != item->parent() || newItem->name() != item->name())) {
+            const auto renamed = newItem->parent() == item->parent();
+            ++(renamed ? summary.renamed : summary.moved);
+            cout << (renamed ? "R " : "M ") << qPrintable(item->relativePath()) << " -> " << qPrintable(newItem->relativePath()) << '\n';
+        } else if (item->type() == ItemType::File) {
+            ++summary.unchanged;
+            if (verbose) {
+                cout << "  " << qPrintable(item->relativePath()) << ": " << qPrintable(item->note()) << '\n';
+            }
+        }
+        if (item->type() == ItemType::Dir) {
+            printRenamingChanges(item, verbose, summary);
+        }
+    }
+}
+
+/*!
+ * \brief Renames the files within the specified \a directory using the RenamingEngine of the renaming utility.
+ * \remarks Runs the engine within a QCoreApplication so no display is required. The engine generates the preview in a
+ *          separate thread (parsing files in parallel) and reports back via queued connections.
+ */
+static void renameDirectoryViaEngine(const char *directory, const QString &program, bool isTemplate, bool recursive, bool dryRun,
+    const Argument &jobsArg, bool verbose)
+{
+    using namespace RenamingUtility;
+    int argc = 1;
+    char appName[] = PROJECT_NAME;
+    char *argv[] = { appName, nullptr };
+    QCoreApplication application(argc, argv);
+
+    RenamingEngine engine;
+    if (!(isTemplate ? engine.setTemplate(program) : engine.setProgram(program))) {
+        cerr << Phrases::Error << (isTemplate ? "The specified template is invalid: " : "The specified script is invalid: ")
+             << qPrintable(engine.errorMessage());
+        if (engine.errorLineNumber()) {
+            cerr << " (line " << engine.errorLineNumber() << ')';
+        }
+        cerr << Phrases::End;
+        exit(-1);
+    }
+    if (const auto jobs = static_cast<int>(parseUInt64(jobsArg, 0))) {
+        QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+        engine.setMaxThreadCount(jobs);
+    }
+
+    // stop generating the preview/applying changes when interrupted
+    const InterruptHandler handler([&engine] { engine.abort(); });
+
+    // generate preview and apply changes (unless only a dry run is requested) and print the changes when done
+    RenamingSummary summary;
+    const auto printChanges = [&] {
+        if (const auto *const rootItem = engine.rootItem()) {
+            printRenamingChanges(rootItem, verbose, summary);
+        }
+        cout << (dryRun ? "Would rename " : "Renamed ") << summary.renamed << " and " << (dryRun ? "move " : "moved ") << summary.moved
+             << " file(s), " << summary.unchanged << " unchanged, " << summary.failed << " error(s)." << endl;
+        application.quit();
+    };
+    QObject::connect(&engine, &RenamingEngine::previewGenerated, [&] {
+        if (dryRun || engine.isAborted() || !engine.applyChangings()) {
+            printChanges();
+        }
+    });
+    QObject::connect(&engine, &RenamingEngine::changingsApplied, printChanges);
+    if (!engine.generatePreview(QDir(fromNativeFileName(directory)), recursive)) {
+        cerr << Phrases::Error << "Unable to generate the preview." << Phrases::End;
+        exit(-1);
+    }
+    application.exec();
+
+    if (engine.isAborted()) {
+        cerr << Phrases::Warning << "The operation has been aborted." << Phrases::EndFlush;
+    }
+    if (summary.failed) {
+        exit(1);
+    }
+}
+#endif
+
+void renameFiles(const ArgumentOccurrence &, const Argument &filesArg, const Argument &dirArg, const Argument &templateArg, const Argument &scriptArg,
+    const Argument &targetDirArg, const Argument &recursiveArg, const Argument &dryRunArg, const Argument &jobsArg, const Argument &verboseArg)
+{
+    CMD_UTILS_START_CONSOLE;
+
+    // check whether exactly one source for the new names and either files or a directory have been specified
+    if (templateArg.isPresent() == scriptArg.isPresent()) {
+        cerr << Phrases::Error << "Either a template or a script must be specified." << Phrases::End;
+        exit(-1);
+    }
+    if (dirArg.isPresent() == (filesArg.isPresent() && !filesArg.values().empty())) {
+        cerr << Phrases::Error << "Either files or a directory must be specified." << Phrases::End;
+        exit(-1);
+    }
+    const auto dryRun = dryRunArg.isPresent();
+    const auto verbose = verboseArg.isPresent();
+
+    // rename files via template without involving Qt
+    if (!dirArg.isPresent()) {
+        if (scriptArg.isPresent()) {
+            cerr << Phrases::Error << "A script can only be used in combination with --dir." << Phrases::End;
+            exit(-1);
+        }
+        RenamingUtility::RenamingTemplate renamingTemplate;
+        if (!renamingTemplate.compile(templateArg.values().front())) {
+            cerr << Phrases::Error << "The specified template is invalid: " << renamingTemplate.errorMessage() << Phrases::End
+                 << "note: Available fields are " << RenamingUtility::RenamingTemplate::fieldNames() << '.' << endl;
+            exit(-1);
+        }
+        renameFilesViaTemplate(
+            filesArg, renamingTemplate, targetDirArg.isPresent() ? targetDirArg.values().front() : nullptr, dryRun, jobsArg, verbose);
+        return;
+    }
+
+    // rename files within directory via the engine of the renaming utility
+#if defined(TAGEDITOR_GUI_QTWIDGETS) && !defined(TAGEDITOR_NO_JSENGINE)
+    if (targetDirArg.isPresent()) {
+        cerr << Phrases::Error << "A target directory can not be combined with --dir; new paths are relative to the specified directory."
+             << Phrases::End;
+        exit(-1);
+    }
+    QString program;
+    if (templateArg.isPresent()) {
+        program = QString::fromUtf8(templateArg.values().front());
+    } else {
+        QFile scriptFile(fromNativeFileName(scriptArg.values().front()));
+        if (!scriptFile.open(QFile::ReadOnly)) {
+            cerr << Phrases::Error << "Unable to open the script \"" << scriptArg.values().front() << "\"." << Phrases::End;
+            exit(-1);
+        }
+        program = QString::fromUtf8(scriptFile.readAll());
+    }
+    renameDirectoryViaEngine(dirArg.values().front(), program, templateArg.isPresent(), recursiveArg.isPresent(), dryRun, jobsArg, verbose);
+#else
+    CPP_UTILITIES_UNUSED(recursiveArg);
+    cerr << Phrases::Error
+         << "Renaming a directory requires the tag editor to be built with Qt widgets GUI and JavaScript support; use --files and --template "
+            "instead."
+         << Phrases::EndFlush;
+    exit(-1);
+#endif
+}
+
+void applyGeneralConfig(const Argument &timeSapnFormatArg, const Argument &ioPriorityArg, const Argument &ioRateLimitArg)
 {
     timeSpanOutputFormat = parseTimeSpanOutputFormat(timeSapnFormatArg, TimeSpanOutputFormat::WithMeasures);
+    applyIoPriority(ioPriorityArg);
+    ioRateLimit = parseIoRateLimit(ioRateLimitArg);
 }
 } // namespace Cli
@@ -47,17 +47,31 @@ struct SetTagInfoArgs {
 
 extern const char *const fieldNames;
 extern const char *const fieldNamesForSet;
-void applyGeneralConfig(const CppUtilities::Argument &timeSapnFormatArg);
+void applyGeneralConfig(
+    const CppUtilities::Argument &timeSapnFormatArg, const CppUtilities::Argument &ioPriorityArg, const CppUtilities::Argument &ioRateLimitArg);
 void printFieldNames(const CppUtilities::ArgumentOccurrence &occurrence);
 void displayFileInfo(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &filesArg, const CppUtilities::Argument &verboseArg);
 void generateFileInfo(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &inputFileArg,
-    const CppUtilities::Argument &outputFileArg, const CppUtilities::Argument &validateArg);
+    const CppUtilities::Argument &outputFileArg, const CppUtilities::Argument &outputDirArg, const CppUtilities::Argument &validateArg,
+    const CppUtilities::Argument &jobsArg);
 void displayTagInfo(const CppUtilities::Argument &fieldsArg, const CppUtilities::Argument &showUnsupportedArg, const CppUtilities::Argument &filesArg,
-    const CppUtilities::Argument &verboseArg);
+    const CppUtilities::Argument &verboseArg, const CppUtilities::Argument &formatArg);
 void setTagInfo(const Cli::SetTagInfoArgs &args);
 void extractField(const CppUtilities::Argument &fieldArg, const CppUtilities::Argument &attachmentArg, const CppUtilities::Argument &inputFilesArg,
     const CppUtilities::Argument &outputFileArg, const CppUtilities::Argument &verboseArg);
-void exportToJson(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &filesArg, const CppUtilities::Argument &prettyArg);
+void exportToJson(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &filesArg, const CppUtilities::Argument &prettyArg,
+    const CppUtilities::Argument &sinceArg, const CppUtilities::Argument &formatArg);
+void validateFiles(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &filesArg, const CppUtilities::Argument &jobsArg,
+    const CppUtilities::Argument &formatArg, const CppUtilities::Argument &verboseArg);
+void importFromJson(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &inputFileArg, const CppUtilities::Argument &filesArg,
+    const CppUtilities::Argument &jobsArg, const CppUtilities::Argument &verboseArg);
+void normalizeCovers(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &filesArg, const CppUtilities::Argument &maxSizeArg,
+    const CppUtilities::Argument &formatArg, const CppUtilities::Argument &qualityArg, const CppUtilities::Argument &jobsArg,
+    const CppUtilities::Argument &verboseArg);
+void renameFiles(const CppUtilities::ArgumentOccurrence &, const CppUtilities::Argument &filesArg, const CppUtilities::Argument &dirArg,
+    const CppUtilities::Argument &templateArg, const CppUtilities::Argument &scriptArg, const CppUtilities::Argument &targetDirArg,
+    const CppUtilities::Argument &recursiveArg, const CppUtilities::Argument &dryRunArg, const CppUtilities::Argument &jobsArg,
+    const CppUtilities::Argument &verboseArg);
 
 } // namespace Cli
 
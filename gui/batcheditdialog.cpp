@@ -0,0 +1,397 @@
+#include "./batcheditdialog.h"
+
+#include "../application/settings.h"
+#include "../cli/helper.h"
+
+#include "resources/config.h"
+#include "ui_batcheditdialog.h"
+
+#include <tagparser/abortableprogressfeedback.h>
+#include <tagparser/exceptions.h>
+#include <tagparser/mediafileinfo.h>
+#include <tagparser/settings.h>
+
+#include <qtutilities/misc/conversion.h>
+#include <qtutilities/misc/dialogutils.h>
+
+#include <c++utilities/conversion/stringbuilder.h>
+
+#include <QCheckBox>
+#include <QCloseEvent>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QtConcurrent>
+
+#include <functional>
+
+using namespace std;
+using namespace CppUtilities;
+using namespace QtUtilities;
+using namespace TagParser;
+
+namespace QtGui {
+
+/*!
+ * \class QtGui::BatchEditDialog
+ * \brief The BatchEditDialog class allows editing fields of multiple files at once.
+ *
+ * The fields enabled in the editor settings are shown. Checked fields are applied to all files which
+ * are processed in parallel using the global thread pool. Values marked to be incremented are handled
+ * like the "+field=value" syntax of the CLI so the n-th file gets the value incremented n times.
+ */
+
+/*!
+ * \brief The ApplySettings struct holds the settings relevant for applying changes to a file.
+ * \remarks The settings are copied on the GUI thread when starting so the worker threads never access Settings::values().
+ */
+struct BatchEditDialog::ApplySettings {
+    bool autoTagManagement = false;
+    TagCreationSettings creationSettings;
+    std::vector<TagTargetLevel> targetLevels;
+    Settings::FileLayout fileLayout;
+    std::string backupDirectory;
+    TagTextEncoding preferredEncoding = TagTextEncoding::Utf8;
+};
+
+/*!
+ * \brief Constructs a new dialog for editing the files at the specified \a paths.
+ */
+BatchEditDialog::BatchEditDialog(const QStringList &paths, QWidget *parent)
+    : QDialog(parent)
+    , m_ui(new Ui::BatchEditDialog)
+    , m_paths(paths)
+    , m_aborted(false)
+    , m_failedCount(0)
+{
+    m_ui->setupUi(this);
+#ifdef Q_OS_WIN32
+    setStyleSheet(dialogStyle());
+#endif
+    setupFieldRows();
+    m_ui->statusLabel->setText(tr("%1 file(s) selected").arg(m_paths.size()));
+    m_ui->progressBar->setMaximum(m_paths.size());
+    m_ui->abortPushButton->setHidden(true);
+
+    connect(m_ui->applyPushButton, &QPushButton::clicked, this, &BatchEditDialog::startApplying);
+    connect(m_ui->abortPushButton, &QPushButton::clicked, this, &BatchEditDialog::abort);
+    connect(m_ui->closePushButton, &QPushButton::clicked, this, &BatchEditDialog::close);
+    connect(&m_watcher, &QFutureWatcherBase::progressValueChanged, m_ui->progressBar, &QProgressBar::setValue);
+    connect(&m_watcher, &QFutureWatcherBase::resultReadyAt, this, &BatchEditDialog::showResult);
+    connect(&m_watcher, &QFutureWatcherBase::finished, this, &BatchEditDialog::showFinished);
+}
+
+/*!
+ * \brief Destroys the dialog waiting for files which are currently processed.
+ */
+BatchEditDialog::~BatchEditDialog()
+{
+    m_aborted = true;
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+/*!
+ * \brief Prevents closing the dialog while files are processed.
+ */
+void BatchEditDialog::closeEvent(QCloseEvent *event)
+{
+    if (isApplying()) {
+        QMessageBox::warning(this, windowTitle(), tr("Abort the ongoing operation before closing the dialog."));
+        event->ignore();
+        return;
+    }
+    QDialog::closeEvent(event);
+}
+
+/*!
+ * \brief Adds a row for each field enabled in the editor settings.
+ * \remarks The value of the cover field is interpreted as path to an image file.
+ */
+void BatchEditDialog::setupFieldRows()
+{
+    auto *const layout = static_cast<QGridLayout *>(m_ui->fieldsWidget->layout());
+    int row = 0;
+    for (const auto &item : Settings::values().editor.fields.items()) {
+        if (!item.isChecked()) {
+            continue;
+        }
+        const auto field = static_cast<KnownField>(item.id().toInt());
+        auto *const applyCheckBox = new QCheckBox(item.label(), m_ui->fieldsWidget);
+        auto *const valueLineEdit = new QLineEdit(m_ui->fieldsWidget);
+        auto *const incrementCheckBox = new QCheckBox(tr("increment"), m_ui->fieldsWidget);
+        if (field == KnownField::Cover) {
+            valueLineEdit->setPlaceholderText(tr("path of image file"));
+            incrementCheckBox->setEnabled(false);
+        }
+        connect(valueLineEdit, &QLineEdit::textEdited, applyCheckBox, [applyCheckBox] { applyCheckBox->setChecked(true); });
+        layout->addWidget(applyCheckBox, row, 0);
+        layout->addWidget(valueLineEdit, row, 1);
+        layout->addWidget(incrementCheckBox, row, 2);
+        m_rows.emplace_back(FieldRow{ field, applyCheckBox, valueLineEdit, incrementCheckBox });
+        ++row;
+    }
+    layout->setRowStretch(row, 1);
+}
+
+/*!
+ * \brief Returns whether files are currently processed.
+ */
+bool BatchEditDialog::isApplying() const
+{
+    return m_watcher.isRunning();
+}
+
+/*!
+ * \brief Starts applying the checked fields to all files.
+ *
+ * The values are taken from the UI before starting so the worker threads never access widgets.
+ */
+void BatchEditDialog::startApplying()
+{
+    if (isApplying()) {
+        return;
+    }
+    m_values.clear();
+    for (const auto &row : m_rows) {
+        if (!row.applyCheckBox->isChecked()) {
+            continue;
+        }
+        FieldValue value{ row.field, row.valueLineEdit->text().toStdString(), row.incrementCheckBox->isChecked(), TagValue() };
+        if (row.field == KnownField::Cover && !value.value.empty()) {
+            // read the cover only once for all files
+            try {
+                MediaFileInfo coverInfo(toNativeFileName(row.valueLineEdit->text()).data());
+                Diagnostics diag;
+                coverInfo.open(true);
+                coverInfo.parseContainerFormat(diag);
+                auto buff = make_unique<char[]>(coverInfo.size());
+                coverInfo.stream().seekg(static_cast<streamoff>(coverInfo.containerOffset()));
+                coverInfo.stream().read(buff.get(), static_cast<streamoff>(coverInfo.size()));
+                value.picture.assignData(move(buff), coverInfo.size(), TagDataType::Picture);
+                value.picture.setMimeType(coverInfo.mimeType());
+            } catch (const TagParser::Failure &) {
+                QMessageBox::critical(this, windowTitle(), tr("Unable to parse the specified cover file."));
+                return;
+            } catch (const std::ios_base::failure &) {
+                QMessageBox::critical(this, windowTitle(), tr("An IO error occured when reading the specified cover file."));
+                return;
+            }
+        }
+        m_values.emplace_back(move(value));
+    }
+    if (m_values.empty()) {
+        QMessageBox::information(this, windowTitle(), tr("No fields have been checked."));
+        return;
+    }
+
+    // take the settings from the main thread as well
+    const auto &settings = Settings::values();
+    auto applySettings = make_shared<ApplySettings>();
+    applySettings->autoTagManagement = settings.tagPocessing.autoTagManagement;
+    applySettings->creationSettings = settings.tagPocessing.creationSettings;
+    applySettings->creationSettings.requiredTargets.clear();
+    applySettings->creationSettings.flags -= TagCreationFlags::KeepExistingId3v2Version;
+    for (const auto &targetItem : settings.editor.defaultTargets.items()) {
+        if (targetItem.isChecked()) {
+            applySettings->targetLevels.emplace_back(static_cast<TagTargetLevel>(targetItem.id().toInt()));
+        }
+    }
+    applySettings->fileLayout = settings.tagPocessing.fileLayout;
+    applySettings->backupDirectory = settings.editor.backupDirectory;
+    applySettings->preferredEncoding = settings.tagPocessing.preferredEncoding;
+
+    m_ui->resultsListWidget->clear();
+    m_ui->progressBar->setValue(0);
+    m_ui->statusLabel->setText(tr("Applying changes ..."));
+    m_ui->applyPushButton->setEnabled(false);
+    m_ui->closePushButton->setEnabled(false);
+    m_ui->fieldsWidget->setEnabled(false);
+    m_ui->abortPushButton->setHidden(false);
+    m_ui->abortPushButton->setEnabled(true);
+    m_aborted = false;
+    m_failedCount = 0;
+
+    QVector<int> indices;
+    indices.reserve(m_paths.size());
+    for (int index = 0, count = m_paths.size(); index != count; ++index) {
+        indices << index;
+    }
+    const shared_ptr<const ApplySettings> sharedSettings(move(applySettings));
+    const std::function<BatchEditResult(int)> applyToFile = [this, sharedSettings](int index) { return this->applyToFile(index, *sharedSettings); };
+    m_watcher.setFuture(QtConcurrent::mapped(indices, applyToFile));
+}
+
+/*!
+ * \brief Aborts applying changes.
+ * \remarks Files which are currently written are aborted as well; their backup is restored by the tagparser.
+ */
+void BatchEditDialog::abort()
+{
+    m_aborted = true;
+    m_watcher.cancel();
+    m_ui->abortPushButton->setEnabled(false);
+    m_ui->statusLabel->setText(tr("Aborting ..."));
+}
+
+/*!
+ * \brief Adds the result for the file at the specified \a index to the results list.
+ */
+void BatchEditDialog::showResult(int index)
+{
+    const auto result = m_watcher.resultAt(index);
+    auto *const item = new QListWidgetItem(result.message.isEmpty() ? result.path : tr("%1: %2").arg(result.path, result.message));
+    switch (result.level) {
+    case DiagLevel::None:
+    case DiagLevel::Debug:
+    case DiagLevel::Information:
+        item->setIcon(QIcon::fromTheme(QStringLiteral("dialog-ok-apply")));
+        break;
+    case DiagLevel::Warning:
+        item->setIcon(QIcon::fromTheme(QStringLiteral("dialog-warning")));
+        break;
+    default:
+        item->setIcon(QIcon::fromTheme(QStringLiteral("dialog-error")));
+        ++m_failedCount;
+    }
+    m_ui->resultsListWidget->addItem(item);
+    if (result.saved) {
+        emit fileSaved(result.path);
+    }
+}
+
+/*!
+ * \brief Shows the overall status when all files have been processed or the operation has been aborted.
+ */
+void BatchEditDialog::showFinished()
+{
+    const auto processed = m_ui->resultsListWidget->count();
+    if (m_watcher.isCanceled()) {
+        m_ui->statusLabel->setText(tr("Aborted after %1 of %2 file(s)").arg(processed).arg(m_paths.size()));
+    } else if (m_failedCount) {
+        m_ui->statusLabel->setText(tr("%1 of %2 file(s) could not be saved").arg(m_failedCount).arg(m_paths.size()));
+    } else {
+        m_ui->statusLabel->setText(tr("All %1 file(s) have been saved").arg(m_paths.size()));
+    }
+    m_ui->progressBar->setValue(processed);
+    m_ui->abortPushButton->setHidden(true);
+    m_ui->applyPushButton->setEnabled(true);
+    m_ui->closePushButton->setEnabled(true);
+    m_ui->fieldsWidget->setEnabled(true);
+}
+
+/*!
+ * \brief Applies the checked fields to the file at the specified \a index using the specified \a settings.
+ * \remarks Runs within a thread of the global thread pool.
+ */
+BatchEditResult BatchEditDialog::applyToFile(int index, const ApplySettings &settings) const
+{
+    BatchEditResult result;
+    result.path = m_paths.at(index);
+    Diagnostics diag;
+    MediaFileInfo fileInfo(toNativeFileName(result.path).data());
+    fileInfo.setWritingApplication(APP_NAME " v" APP_VERSION);
+    const auto &fileLayoutSettings = settings.fileLayout;
+    fileInfo.setForceRewrite(fileLayoutSettings.forceRewrite);
+    fileInfo.setTagPosition(fileLayoutSettings.preferredTagPosition);
+    fileInfo.setForceTagPosition(fileLayoutSettings.forceTagPosition);
+    fileInfo.setIndexPosition(fileLayoutSettings.preferredIndexPosition);
+    fileInfo.setForceIndexPosition(fileLayoutSettings.forceIndexPosition);
+    fileInfo.setMinPadding(fileLayoutSettings.minPadding);
+    fileInfo.setMaxPadding(fileLayoutSettings.maxPadding);
+    fileInfo.setPreferredPadding(fileLayoutSettings.preferredPadding);
+    fileInfo.setBackupDirectory(settings.backupDirectory);
+
+    const auto checkAborted = [this](AbortableProgressFeedback &progress) {
+        if (m_aborted.load()) {
+            progress.tryToAbort();
+        }
+    };
+    AbortableProgressFeedback progress(checkAborted, checkAborted);
+    try {
+        try {
+            // parse the file
+            if (m_aborted.load()) {
+                throw OperationAbortedException();
+            }
+            fileInfo.open();
+            fileInfo.parseContainerFormat(diag);
+            fileInfo.parseTags(diag);
+            fileInfo.parseTracks(diag);
+            fileInfo.parseAttachments(diag);
+
+            // create appropriate tags according to file type and user preferences when automatic tag management is enabled
+            if (settings.autoTagManagement) {
+                auto creationSettings = settings.creationSettings;
+                for (const auto targetLevel : settings.targetLevels) {
+                    creationSettings.requiredTargets.emplace_back(containerTargetLevelValue(fileInfo.containerFormat(), targetLevel));
+                }
+                if (!fileInfo.createAppropriateTags(creationSettings)) {
+                    // the GUI would ask whether to add an ID3 tag anyways; just skip the file here
+                    result.level = DiagLevel::Warning;
+                    result.message = tr("skipped because the file format does not support tags");
+                    return result;
+                }
+            }
+            const auto tags = fileInfo.tags();
+            if (tags.empty()) {
+                result.level = DiagLevel::Warning;
+                result.message = tr("skipped because the file has no tags");
+                return result;
+            }
+
+            // apply the values
+            for (auto *const tag : tags) {
+                auto encoding = settings.preferredEncoding;
+                if (!tag->canEncodingBeUsed(encoding)) {
+                    encoding = tag->proposedTextEncoding();
+                }
+                for (const auto &value : m_values) {
+                    if (value.value.empty()) {
+                        tag->setValue(value.field, TagValue());
+                    } else if (value.field == KnownField::Cover) {
+                        tag->setValue(value.field, value.picture);
+                    } else if (value.increment && index) {
+                        auto incrementedValue = Cli::incremented(value.value);
+                        for (int i = 1; i != index; ++i) {
+                            incrementedValue = Cli::incremented(incrementedValue);
+                        }
+                        tag->setValue(value.field, TagValue(incrementedValue, TagTextEncoding::Utf8, encoding));
+                    } else {
+                        tag->setValue(value.field, TagValue(value.value, TagTextEncoding::Utf8, encoding));
+                    }
+                }
+            }
+
+            // save the file
+            fileInfo.applyChanges(diag, progress);
+            result.saved = true;
+        } catch (const OperationAbortedException &) {
+            result.level = DiagLevel::Warning;
+            result.message = tr("aborted");
+            return result;
+        } catch (const Failure &) {
+            diag.emplace_back(DiagLevel::Critical, "Unable to parse or save the file.", "batch editing");
+        } catch (const std::ios_base::failure &) {
+            diag.emplace_back(DiagLevel::Critical, "An IO error occured when parsing or saving the file.", "batch editing");
+        }
+    } catch (const exception &e) {
+        diag.emplace_back(DiagLevel::Critical, argsToString("Something completely unexpected happened: ", e.what()), "batch editing");
+    } catch (...) {
+        diag.emplace_back(DiagLevel::Critical, "Something completely unexpected happened", "batch editing");
+    }
+
+    // report the most relevant message
+    result.level = diag.level();
+    if (result.level >= DiagLevel::Warning) {
+        for (const auto &msg : diag) {
+            if (msg.level() == result.level) {
+                result.message = QString::fromStdString(msg.message());
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace QtGui
@@ -0,0 +1,94 @@
+#ifndef BATCHEDITDIALOG_H
+#define BATCHEDITDIALOG_H
+
+#include <tagparser/diagnostics.h>
+#include <tagparser/tag.h>
+
+#include <QDialog>
+#include <QFutureWatcher>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+QT_FORWARD_DECLARE_CLASS(QCheckBox)
+QT_FORWARD_DECLARE_CLASS(QLineEdit)
+
+namespace QtGui {
+
+namespace Ui {
+class BatchEditDialog;
+}
+
+/*!
+ * \brief The BatchEditResult struct holds the result of editing a single file.
+ */
+struct BatchEditResult {
+    QString path;
+    QString message;
+    TagParser::DiagLevel level = TagParser::DiagLevel::None;
+    bool saved = false;
+};
+
+class BatchEditDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit BatchEditDialog(const QStringList &paths, QWidget *parent = nullptr);
+    ~BatchEditDialog() override;
+
+    const QStringList &paths() const;
+
+Q_SIGNALS:
+    /// \brief Emitted when the changes have been applied to the file at the specified \a path.
+    void fileSaved(const QString &path);
+
+protected:
+    void closeEvent(QCloseEvent *event) override;
+
+private Q_SLOTS:
+    void startApplying();
+    void abort();
+    void showResult(int index);
+    void showFinished();
+
+private:
+    struct FieldRow {
+        TagParser::KnownField field;
+        QCheckBox *applyCheckBox;
+        QLineEdit *valueLineEdit;
+        QCheckBox *incrementCheckBox;
+    };
+    struct ApplySettings;
+    struct FieldValue {
+        TagParser::KnownField field;
+        std::string value;
+        bool increment;
+        TagParser::TagValue picture;
+    };
+
+    void setupFieldRows();
+    bool isApplying() const;
+    BatchEditResult applyToFile(int index, const ApplySettings &settings) const;
+
+    std::unique_ptr<Ui::BatchEditDialog> m_ui;
+    QStringList m_paths;
+    std::vector<FieldRow> m_rows;
+    std::vector<FieldValue> m_values;
+    QFutureWatcher<BatchEditResult> m_watcher;
+    std::atomic<bool> m_aborted;
+    int m_failedCount;
+};
+
+/*!
+ * \brief Returns the paths of the files to be edited.
+ */
+inline const QStringList &BatchEditDialog::paths() const
+{
+    return m_paths;
+}
+
+} // namespace QtGui
+
+#endif // BATCHEDITDIALOG_H
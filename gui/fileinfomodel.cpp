@@ -28,6 +28,8 @@
 #endif
 #include <QStringBuilder>
 
+#include <memory>
+
 using namespace std;
 using namespace CppUtilities;
 using namespace QtUtilities;
@@ -116,57 +118,41 @@ private:
     QStandardItem *m_item;
 };
 
-void addDiagMessages(TagParser::Diagnostics *diag, QStandardItem *parent)
+void addDiagMessage(const DiagMessage &msg, QStandardItem *parent)
 {
-    for (const auto &msg : *diag) {
-        QList<QStandardItem *> notificationRow;
-        notificationRow.reserve(3);
-
-        auto *firstItem = defaultItem(QString::fromUtf8(msg.creationTime().toString().data()));
-        switch (msg.level()) {
-        case DiagLevel::None:
-        case DiagLevel::Debug:
-            firstItem->setIcon(FileInfoModel::debugIcon());
-            break;
-        case DiagLevel::Information:
-            firstItem->setIcon(FileInfoModel::informationIcon());
-            break;
-        case DiagLevel::Warning:
-            firstItem->setIcon(FileInfoModel::warningIcon());
-            break;
-        case DiagLevel::Critical:
-        case DiagLevel::Fatal:
-            firstItem->setIcon(FileInfoModel::errorIcon());
-            break;
-        }
-        parent->appendRow(QList<QStandardItem *>() << firstItem << defaultItem(QString::fromUtf8(msg.message().data()))
-                                                   << defaultItem(QString::fromUtf8(msg.context().data())));
+    auto *firstItem = defaultItem(QString::fromUtf8(msg.creationTime().toString().data()));
+    switch (msg.level()) {
+    case DiagLevel::None:
+    case DiagLevel::Debug:
+        firstItem->setIcon(FileInfoModel::debugIcon());
+        break;
+    case DiagLevel::Information:
+        firstItem->setIcon(FileInfoModel::informationIcon());
+        break;
+    case DiagLevel::Warning:
+        firstItem->setIcon(FileInfoModel::warningIcon());
+        break;
+    case DiagLevel::Critical:
+    case DiagLevel::Fatal:
+        firstItem->setIcon(FileInfoModel::errorIcon());
+        break;
     }
+    parent->appendRow(QList<QStandardItem *>() << firstItem << defaultItem(QString::fromUtf8(msg.message().data()))
+                                               << defaultItem(QString::fromUtf8(msg.context().data())));
 }
 
-template <class ElementType, bool isAdditional = false> void addElementNode(const ElementType *element, QStandardItem *parent)
+/// \brief Returns a generator which invokes \a addRow for the indices from 0 to \a count.
+template <typename Function> std::function<bool(QStandardItem *)> rowsByIndex(std::size_t count, Function addRow)
 {
-    while (element) {
-        if (element->isParsed()) {
-            auto *firstItem = defaultItem(QString::fromLatin1(element->idToString().data()));
-            parent->appendRow(QList<QStandardItem *>() << firstItem
-                                                       << defaultItem(QStringLiteral("offset: 0x") % QString::number(element->startOffset(), 16)
-                                                              % QStringLiteral(", size: 0x") % QString::number(element->totalSize(), 16)));
-            if (element->firstChild()) {
-                addElementNode(element->firstChild(), firstItem);
-            }
-            element = element->nextSibling();
-        } else {
-            if (!isAdditional) {
-                auto *notAnalyzedItem = defaultItem(QStringLiteral("not analyzed"));
-                notAnalyzedItem->setForeground(QBrush(QColor(Qt::red)));
-                parent->appendRow(notAnalyzedItem);
-            }
-            break;
-        }
-    }
+    return [count, addRow, index = std::size_t()](QStandardItem *parent) mutable {
+        addRow(parent, index);
+        return ++index < count;
+    };
 }
 
+/// \brief The number of rows materialized by a single call of FileInfoModel::fetchMore().
+constexpr int fetchBatchSize = 200;
+
 /*!
  * \endcond
  */
@@ -178,6 +164,11 @@ template <class ElementType, bool isAdditional = false> void addElementNode(cons
  * The model assumes that the specified TagParser::MediaFileInfo instance has been parsed already.
  * The model is not updated automatically when the state of the TagParser::MediaFileInfo changes.
  * To update the model, just call setFileInfo() again.
+ *
+ * Only the top-level rows are created immediately. The rows for tracks, attachments, chapters, the element
+ * structure and diagnostic messages are created when the corresponding item is expanded (see fetchMore()).
+ * Hence the TagParser::MediaFileInfo and the diagnostics must not be modified or destroyed while rows are
+ * still pending; call discardPendingRows() before doing so.
  */
 
 /*!
@@ -212,6 +203,65 @@ QVariant FileInfoModel::headerData(int section, Qt::Orientation orientation, int
     return QVariant();
 }
 
+/*!
+ * \brief Returns whether the item at \a parent has children including the ones which have not been created yet.
+ */
+bool FileInfoModel::hasChildren(const QModelIndex &parent) const
+{
+    return m_pendingRows.find(itemFromIndex(parent)) != m_pendingRows.cend() || QStandardItemModel::hasChildren(parent);
+}
+
+/*!
+ * \brief Returns whether there are rows for the item at \a parent which have not been created yet.
+ */
+bool FileInfoModel::canFetchMore(const QModelIndex &parent) const
+{
+    return m_pendingRows.find(itemFromIndex(parent)) != m_pendingRows.cend();
+}
+
+/*!
+ * \brief Creates the next batch of pending rows for the item at \a parent.
+ */
+void FileInfoModel::fetchMore(const QModelIndex &parent)
+{
+    auto *const parentItem = itemFromIndex(parent);
+    const auto pending = m_pendingRows.find(parentItem);
+    if (pending == m_pendingRows.end()) {
+        return;
+    }
+    // take the generator out of the map because it might add pending rows for the new items
+    auto generator = move(pending->second);
+    m_pendingRows.erase(pending);
+    auto morePending = true;
+    for (int i = 0; morePending && i != fetchBatchSize; ++i) {
+        morePending = generator(parentItem);
+    }
+    if (morePending) {
+        m_pendingRows[parentItem] = move(generator);
+    }
+}
+
+/*!
+ * \brief Discards all rows which have not been created yet.
+ *
+ * Instead of the discarded rows, a row stating that further entries are not available is appended to the affected
+ * items. So the model does not need to be reset and expanded items keep the rows which have already been created.
+ *
+ * \remarks Must be called before the assigned TagParser::MediaFileInfo or diagnostics are modified or destroyed
+ *          if the model is not updated via setFileInfo() anyways.
+ */
+void FileInfoModel::discardPendingRows()
+{
+    // take the generators out of the map first because appending rows makes views query canFetchMore()
+    const auto pendingRows = move(m_pendingRows);
+    m_pendingRows.clear();
+    for (const auto &pending : pendingRows) {
+        auto *const discardedItem = defaultItem(tr("further entries are not available while the file is being saved or reloaded"));
+        discardedItem->setForeground(QBrush(QColor(Qt::gray)));
+        pending.first->appendRow(discardedItem);
+    }
+}
+
 /*!
  * \brief Returns the currently assigned TagParser::MediaFileInfo.
  */
@@ -271,12 +321,46 @@ const QIcon &FileInfoModel::debugIcon()
     return icon;
 }
 
+/*!
+ * \brief Registers the rows provided by \a generator to be created when \a parent is expanded.
+ */
+void FileInfoModel::addPendingRows(QStandardItem *parent, RowGenerator &&generator)
+{
+    m_pendingRows[parent] = move(generator);
+}
+
+/*!
+ * \brief Returns a generator for the rows of the specified \a element and its siblings.
+ * \remarks Rows for the children of the elements are created lazily as well.
+ */
+template <class ElementType> FileInfoModel::RowGenerator FileInfoModel::elementRows(const ElementType *element)
+{
+    return [this, element](QStandardItem *parent) mutable {
+        if (!element->isParsed()) {
+            auto *notAnalyzedItem = defaultItem(QStringLiteral("not analyzed"));
+            notAnalyzedItem->setForeground(QBrush(QColor(Qt::red)));
+            parent->appendRow(notAnalyzedItem);
+            return false;
+        }
+        auto *firstItem = defaultItem(QString::fromLatin1(element->idToString().data()));
+        parent->appendRow(QList<QStandardItem *>() << firstItem
+                                                   << defaultItem(QStringLiteral("offset: 0x") % QString::number(element->startOffset(), 16)
+                                                          % QStringLiteral(", size: 0x") % QString::number(element->totalSize(), 16)));
+        if (element->firstChild()) {
+            addPendingRows(firstItem, elementRows(element->firstChild()));
+        }
+        return (element = element->nextSibling()) != nullptr;
+    };
+}
+
 /*!
  * \brief Internally called to cache the items.
+ * \remarks Only creates the top-level items; the other items are created by fetchMore().
  */
 void FileInfoModel::updateCache()
 {
     beginResetModel();
+    m_pendingRows.clear();
     clear();
     if (m_file) {
         // get diag
@@ -378,9 +462,9 @@ void FileInfoModel::updateCache()
                             + QString::fromUtf8(summary.data(), trQuandity(summary.size()))));
                 }
 
-                size_t number = 0;
-                for (const AbstractTrack *track : tracks) {
-                    auto *trackItem = defaultItem(tr("Track #%1").arg(++number));
+                addPendingRows(tracksItem, rowsByIndex(tracks.size(), [tracks](QStandardItem *parent, size_t index) {
+                    const AbstractTrack *const track = tracks[index];
+                    auto *trackItem = defaultItem(tr("Track #%1").arg(index + 1));
                     ItemHelper trackHelper(trackItem);
                     trackHelper.appendRow(tr("ID"), track->id());
                     trackHelper.appendRow(tr("Number"), track->trackNumber());
@@ -467,8 +551,8 @@ void FileInfoModel::updateCache()
                     if (!labels.isEmpty()) {
                         trackHelper.appendRow(tr("Labeled as"), labels.join(QStringLiteral(", ")));
                     }
-                    tracksItem->appendRow(trackItem);
-                }
+                    parent->appendRow(trackItem);
+                }));
             }
         }
 
@@ -480,26 +564,27 @@ void FileInfoModel::updateCache()
                 setItem(++currentRow, attachmentsItem);
                 setItem(currentRow, 1, defaultItem(tr("%1 attachment(s) present", nullptr, trQuandity(attachments.size())).arg(attachments.size())));
 
-                size_t number = 0;
-                for (const AbstractAttachment *attachment : attachments) {
-                    auto *attachmentItem = defaultItem(tr("Attachment #%1").arg(++number));
+                addPendingRows(attachmentsItem, rowsByIndex(attachments.size(), [attachments](QStandardItem *parent, size_t index) {
+                    const AbstractAttachment *const attachment = attachments[index];
+                    auto *attachmentItem = defaultItem(tr("Attachment #%1").arg(index + 1));
                     ItemHelper attachHelper(attachmentItem);
                     attachHelper.appendRow(tr("ID"), attachment->id());
                     attachHelper.appendRow(tr("Name"), attachment->name());
                     attachHelper.appendRow(tr("Size"), dataSizeToString(static_cast<std::uint64_t>(attachment->data()->size())));
                     attachHelper.appendRow(tr("Mime-type"), attachment->mimeType());
                     attachHelper.appendRow(tr("Description"), attachment->description());
-                    attachmentsItem->appendRow(attachmentItem);
-                }
+                    parent->appendRow(attachmentItem);
+                }));
             }
         }
 
         // chapters/editions
         {
-            size_t number = 0;
-            function<void(const AbstractChapter *, QStandardItem *)> addChapter;
-            addChapter = [&addChapter, &number](const AbstractChapter *chapter, QStandardItem *parent) {
-                auto *chapterItem = defaultItem(tr("Chapter #%1").arg(++number));
+            // the nested chapters and the chapters of editions are added lazily as well, so the function needs to be kept alive
+            auto addChapter = make_shared<function<void(const AbstractChapter *, size_t, QStandardItem *)>>();
+            *addChapter = [this, weakAddChapter = weak_ptr<function<void(const AbstractChapter *, size_t, QStandardItem *)>>(addChapter)](
+                              const AbstractChapter *chapter, size_t index, QStandardItem *parent) {
+                auto *chapterItem = defaultItem(tr("Chapter #%1").arg(index + 1));
                 ItemHelper chapterHelper(chapterItem);
                 chapterHelper.appendRow(tr("ID"), chapter->id());
                 for (const LocaleAwareString &name : chapter->names()) {
@@ -532,8 +617,11 @@ void FileInfoModel::updateCache()
                     }
                     chapterHelper.appendRow(tr("Tracks"), trackIds.join(QStringLiteral(", ")));
                 }
-                for (size_t i = 0, nestedChapters = chapter->nestedChapterCount(); i < nestedChapters; ++i) {
-                    addChapter(chapter->nestedChapter(i), chapterItem);
+                if (const auto nestedChapters = chapter->nestedChapterCount()) {
+                    addPendingRows(chapterItem,
+                        rowsByIndex(nestedChapters, [chapter, addChapter = weakAddChapter.lock()](QStandardItem *nestedParent, size_t index) {
+                            (*addChapter)(chapter->nestedChapter(index), index, nestedParent);
+                        }));
                 }
                 parent->appendRow(chapterItem);
             };
@@ -545,29 +633,34 @@ void FileInfoModel::updateCache()
                     setItem(++currentRow, editionsItem);
                     setItem(currentRow, 1,
                         defaultItem(tr("%1 edition(s) present", nullptr, trQuandity(editionEntries.size())).arg(editionEntries.size())));
-                    size_t editionNumber = 0;
-                    for (const auto &edition : editionEntries) {
-                        auto *editionItem = defaultItem(tr("Edition #%1").arg(++editionNumber));
-                        ItemHelper editionHelper(editionItem);
-                        editionHelper.appendRow(tr("ID"), edition->id());
-                        QStringList labels;
-                        if (edition->isHidden()) {
-                            labels << tr("hidden");
-                        }
-                        if (edition->isDefault()) {
-                            labels << tr("default");
-                        }
-                        if (edition->isOrdered()) {
-                            labels << tr("ordered");
-                        }
-                        if (!labels.isEmpty()) {
-                            editionHelper.appendRow(tr("Labeled as"), labels.join(QStringLiteral(", ")));
-                        }
-                        for (const auto &chapter : edition->chapters()) {
-                            addChapter(chapter.get(), editionItem);
-                        }
-                        editionsItem->appendRow(editionItem);
-                    }
+                    addPendingRows(editionsItem,
+                        rowsByIndex(editionEntries.size(), [this, &editionEntries, addChapter](QStandardItem *parent, size_t index) {
+                            const auto &edition = editionEntries[index];
+                            auto *editionItem = defaultItem(tr("Edition #%1").arg(index + 1));
+                            ItemHelper editionHelper(editionItem);
+                            editionHelper.appendRow(tr("ID"), edition->id());
+                            QStringList labels;
+                            if (edition->isHidden()) {
+                                labels << tr("hidden");
+                            }
+                            if (edition->isDefault()) {
+                                labels << tr("default");
+                            }
+                            if (edition->isOrdered()) {
+                                labels << tr("ordered");
+                            }
+                            if (!labels.isEmpty()) {
+                                editionHelper.appendRow(tr("Labeled as"), labels.join(QStringLiteral(", ")));
+                            }
+                            const auto &chapters = edition->chapters();
+                            if (!chapters.empty()) {
+                                addPendingRows(editionItem,
+                                    rowsByIndex(chapters.size(), [&chapters, addChapter](QStandardItem *chapterParent, size_t index) {
+                                        (*addChapter)(chapters[index].get(), index, chapterParent);
+                                    }));
+                            }
+                            parent->appendRow(editionItem);
+                        }));
                 }
             } else {
                 const auto chapters = m_file->chapters();
@@ -575,9 +668,9 @@ void FileInfoModel::updateCache()
                     auto *chaptersItem = defaultItem(tr("Chapters"));
                     setItem(++currentRow, chaptersItem);
                     setItem(currentRow, 1, defaultItem(tr("%1 chapter(s) present", nullptr, trQuandity(chapters.size())).arg(chapters.size())));
-                    for (const AbstractChapter *chapter : chapters) {
-                        addChapter(chapter, chaptersItem);
-                    }
+                    addPendingRows(chaptersItem, rowsByIndex(chapters.size(), [chapters, addChapter](QStandardItem *parent, size_t index) {
+                        (*addChapter)(chapters[index], index, parent);
+                    }));
                 }
             }
         }
@@ -593,12 +686,16 @@ void FileInfoModel::updateCache()
             switch (m_file->containerFormat()) {
             case ContainerFormat::Mp4:
             case ContainerFormat::QuickTime:
-                addElementNode(static_cast<const Mp4Container *>(container)->firstElement(), structureItem);
+                if (const auto *const firstElement = static_cast<const Mp4Container *>(container)->firstElement()) {
+                    addPendingRows(structureItem, elementRows(firstElement));
+                }
                 break;
             case ContainerFormat::Matroska:
             case ContainerFormat::Webm:
             case ContainerFormat::Ebml:
-                addElementNode(static_cast<const MatroskaContainer *>(container)->firstElement(), structureItem);
+                if (const auto *const firstElement = static_cast<const MatroskaContainer *>(container)->firstElement()) {
+                    addPendingRows(structureItem, elementRows(firstElement));
+                }
                 break;
             default:;
             }
@@ -609,13 +706,18 @@ void FileInfoModel::updateCache()
         }
 
         // notifications
-        auto *const diagItem = defaultItem(tr("Diagnostic messages"));
-        addDiagMessages(m_diag, diagItem);
-        setItem(++currentRow, diagItem);
+        const auto addDiagItem = [this, &currentRow](const QString &label, const Diagnostics *diag) {
+            auto *const diagItem = defaultItem(label);
+            if (!diag->empty()) {
+                addPendingRows(diagItem, rowsByIndex(diag->size(), [diag](QStandardItem *parent, size_t index) {
+                    addDiagMessage((*diag)[index], parent);
+                }));
+            }
+            setItem(++currentRow, diagItem);
+        };
+        addDiagItem(tr("Diagnostic messages"), m_diag);
         if (m_diagReparsing) {
-            auto *diagReparsingItem = defaultItem(tr("Diagnostic messages from reparsing"));
-            addDiagMessages(m_diagReparsing, diagReparsingItem);
-            setItem(++currentRow, diagReparsingItem);
+            addDiagItem(tr("Diagnostic messages from reparsing"), m_diagReparsing);
         }
     }
     endResetModel();
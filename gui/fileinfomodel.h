@@ -4,7 +4,8 @@
 #include <QIcon>
 #include <QStandardItemModel>
 
-#include <list>
+#include <functional>
+#include <unordered_map>
 
 namespace TagParser {
 class MediaFileInfo;
@@ -19,9 +20,13 @@ public:
     explicit FileInfoModel(QObject *parent = nullptr);
 
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
 
     const TagParser::MediaFileInfo *fileInfo() const;
     void setFileInfo(TagParser::MediaFileInfo &fileInfo, TagParser::Diagnostics &diag, TagParser::Diagnostics *diagReparsing = nullptr);
+    void discardPendingRows();
 
     static const QIcon &informationIcon();
     static const QIcon &warningIcon();
@@ -29,9 +34,15 @@ public:
     static const QIcon &debugIcon();
 
 private:
+    /// \brief Appends the next row to the specified parent and returns whether further rows are pending.
+    using RowGenerator = std::function<bool(QStandardItem *)>;
+
     void updateCache();
+    void addPendingRows(QStandardItem *parent, RowGenerator &&generator);
+    template <class ElementType> RowGenerator elementRows(const ElementType *element);
 
 private:
+    std::unordered_map<QStandardItem *, RowGenerator> m_pendingRows;
     TagParser::MediaFileInfo *m_file;
     TagParser::Diagnostics *m_diag;
     TagParser::Diagnostics *m_diagReparsing;
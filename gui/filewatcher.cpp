@@ -0,0 +1,173 @@
+#include "./filewatcher.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QSocketNotifier>
+#include <QStringBuilder>
+
+#ifdef PLATFORM_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace QtGui {
+
+/*!
+ * \class QtGui::FileWatcher
+ * \brief The FileWatcher class watches directories for changes of the files they contain.
+ *
+ * The watcher is shared by all components caching information about files (eg. the tag editor widget or the
+ * tag status of the file browser) so each directory is only watched once. Under Linux inotify is used directly
+ * which allows reporting the particular file which has been written, created, moved or deleted. Otherwise (or if
+ * inotify is not available) QFileSystemWatcher is used which only reports the directory.
+ *
+ * Directories are reference-counted so every call of watchDirectory() must be followed by a call of unwatchDirectory().
+ */
+
+/*!
+ * \brief Returns the instance shared within the application.
+ * \remarks The instance is a child of the application object so it must not be used before the application object has
+ *          been created.
+ */
+FileWatcher &FileWatcher::instance()
+{
+    static auto *const watcher = new FileWatcher(QCoreApplication::instance());
+    return *watcher;
+}
+
+/*!
+ * \brief Constructs a new watcher.
+ */
+FileWatcher::FileWatcher(QObject *parent)
+    : QObject(parent)
+#ifdef PLATFORM_LINUX
+    , m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    , m_notifier(nullptr)
+#endif
+    , m_fallbackWatcher(nullptr)
+{
+#ifdef PLATFORM_LINUX
+    if (m_fd >= 0) {
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated, this, &FileWatcher::readEvents);
+        return;
+    }
+#endif
+    m_fallbackWatcher = new QFileSystemWatcher(this);
+    connect(m_fallbackWatcher, &QFileSystemWatcher::directoryChanged, this, &FileWatcher::directoryChanged);
+}
+
+/*!
+ * \brief Destroys the watcher.
+ */
+FileWatcher::~FileWatcher()
+{
+#ifdef PLATFORM_LINUX
+    if (m_fd >= 0) {
+        delete m_notifier;
+        ::close(m_fd);
+    }
+#endif
+}
+
+/*!
+ * \brief Starts watching the directory at the specified \a path (if not watched already).
+ */
+void FileWatcher::watchDirectory(const QString &path)
+{
+    const auto dir = QDir::cleanPath(path);
+    if (dir.isEmpty() || m_watchCount[dir]++) {
+        return;
+    }
+    if (m_fallbackWatcher) {
+        m_fallbackWatcher->addPath(dir);
+        return;
+    }
+#ifdef PLATFORM_LINUX
+    const auto descriptor = inotify_add_watch(m_fd, QFile::encodeName(dir).constData(),
+        IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ONLYDIR);
+    if (descriptor >= 0) {
+        m_directoriesByDescriptor[descriptor] = dir;
+        m_descriptorsByDirectory[dir] = descriptor;
+    }
+#endif
+}
+
+/*!
+ * \brief Stops watching the directory at the specified \a path (if not watched by other components anymore).
+ */
+void FileWatcher::unwatchDirectory(const QString &path)
+{
+    const auto dir = QDir::cleanPath(path);
+    const auto count = m_watchCount.find(dir);
+    if (count == m_watchCount.end() || --count.value()) {
+        return;
+    }
+    m_watchCount.erase(count);
+    if (m_fallbackWatcher) {
+        m_fallbackWatcher->removePath(dir);
+        return;
+    }
+#ifdef PLATFORM_LINUX
+    const auto descriptor = m_descriptorsByDirectory.find(dir);
+    if (descriptor != m_descriptorsByDirectory.end()) {
+        inotify_rm_watch(m_fd, descriptor.value());
+        m_directoriesByDescriptor.remove(descriptor.value());
+        m_descriptorsByDirectory.erase(descriptor);
+    }
+#endif
+}
+
+/*!
+ * \brief Reads pending inotify events and emits the corresponding signals.
+ */
+void FileWatcher::readEvents()
+{
+#ifdef PLATFORM_LINUX
+    alignas(inotify_event) char buffer[0x1000];
+    for (;;) {
+        const auto bytesRead = ::read(m_fd, buffer, sizeof(buffer));
+        if (bytesRead <= 0) {
+            return;
+        }
+        for (const char *i = buffer, *end = buffer + bytesRead; i < end;) {
+            const auto *const event = reinterpret_cast<const inotify_event *>(i);
+            i += sizeof(inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                // events have been lost -> consider all directories as changed (iterating over a copy because slots
+                // might watch/unwatch directories)
+                const auto directories = m_directoriesByDescriptor;
+                for (const auto &dir : directories) {
+                    emit directoryChanged(dir);
+                }
+                continue;
+            }
+            const auto dir = m_directoriesByDescriptor.find(event->wd);
+            if (dir == m_directoriesByDescriptor.end()) {
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                // the directory has been deleted or unmounted; the watch is removed implicitly so watching the directory
+                // again (eg. when it has been re-created) must add a new watch
+                m_watchCount.remove(dir.value());
+                m_descriptorsByDirectory.remove(dir.value());
+                m_directoriesByDescriptor.erase(dir);
+                continue;
+            }
+            if (!event->len || (event->mask & IN_ISDIR)) {
+                continue;
+            }
+            const QString path = dir.value() % QChar('/') % QFile::decodeName(event->name);
+            if (event->mask & (IN_MOVED_FROM | IN_DELETE)) {
+                emit fileRemoved(path);
+            } else {
+                emit fileChanged(path);
+            }
+        }
+    }
+#endif
+}
+
+} // namespace QtGui
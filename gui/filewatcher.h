@@ -0,0 +1,61 @@
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <c++utilities/application/global.h>
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+QT_FORWARD_DECLARE_CLASS(QFileSystemWatcher)
+QT_FORWARD_DECLARE_CLASS(QSocketNotifier)
+
+namespace QtGui {
+
+class FileWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    static FileWatcher &instance();
+
+    void watchDirectory(const QString &path);
+    void unwatchDirectory(const QString &path);
+    bool isPrecise() const;
+
+Q_SIGNALS:
+    /// \brief Emitted when the file at the specified \a path has been written, created or moved into a watched directory.
+    void fileChanged(const QString &path);
+    /// \brief Emitted when the file at the specified \a path has been deleted or moved out of a watched directory.
+    void fileRemoved(const QString &path);
+    /// \brief Emitted when it is unknown which files within the directory at the specified \a path have changed.
+    /// \remarks This is always the case when isPrecise() returns false. Otherwise it only happens when events have been lost.
+    void directoryChanged(const QString &path);
+
+private Q_SLOTS:
+    void readEvents();
+
+private:
+    explicit FileWatcher(QObject *parent = nullptr);
+    ~FileWatcher() override;
+
+    QHash<QString, int> m_watchCount;
+#ifdef PLATFORM_LINUX
+    int m_fd;
+    QSocketNotifier *m_notifier;
+    QHash<int, QString> m_directoriesByDescriptor;
+    QHash<QString, int> m_descriptorsByDirectory;
+#endif
+    QFileSystemWatcher *m_fallbackWatcher;
+};
+
+/*!
+ * \brief Returns whether changes are reported for individual files (rather than just for directories).
+ */
+inline bool FileWatcher::isPrecise() const
+{
+    return !m_fallbackWatcher;
+}
+
+} // namespace QtGui
+
+#endif // FILEWATCHER_H
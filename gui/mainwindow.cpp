@@ -1,8 +1,11 @@
 #include "./mainwindow.h"
+#include "./batcheditdialog.h"
 #include "./dbquerywidget.h"
 #include "./renamefilesdialog.h"
+#include "./savequeue.h"
 #include "./settingsdialog.h"
 #include "./tageditorwidget.h"
+#include "./tagstatusfilesystemmodel.h"
 
 #include "../application/settings.h"
 #include "../misc/htmlinfo.h"
@@ -25,7 +28,6 @@
 
 #include <QCoreApplication>
 #include <QFileDialog>
-#include <QFileSystemModel>
 #include <QMessageBox>
 
 #include <iomanip>
@@ -88,7 +90,7 @@ MainWindow::MainWindow(QWidget *parent)
     restoreState(settings.mainWindow.state);
 
     // setup file model and file tree view
-    m_fileModel = new QFileSystemModel(this);
+    m_fileModel = new TagStatusFileSystemModel(this);
     m_fileModel->setRootPath(QString());
     m_fileFilterModel = new FileFilterProxyModel(this);
     m_fileFilterModel->setExtensionsToBeFiltered(QStringList() << QStringLiteral("bak") << QStringLiteral("tmp"));
@@ -124,13 +126,17 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_ui->actionSave_as, &QAction::triggered, this, &MainWindow::showSaveAsDlg);
     connect(m_ui->actionDelete_all_tags, &QAction::triggered, m_ui->tagEditorWidget, &TagEditorWidget::deleteAllTagsAndSave);
     connect(m_ui->actionSave_file_information, &QAction::triggered, m_ui->tagEditorWidget, &TagEditorWidget::saveFileInfo);
+    connect(m_ui->actionAbort_saving_in_background, &QAction::triggered, &m_ui->tagEditorWidget->saveQueue(), &SaveQueue::abortAll);
+    connect(&m_ui->tagEditorWidget->saveQueue(), &SaveQueue::busyChanged, m_ui->actionAbort_saving_in_background, &QAction::setEnabled);
     connect(m_ui->actionClose, &QAction::triggered, m_ui->tagEditorWidget, &TagEditorWidget::closeFile);
     connect(m_ui->actionReload, &QAction::triggered, m_ui->tagEditorWidget, &TagEditorWidget::reparseFile);
     connect(m_ui->actionExternalPlayer, &QAction::triggered, this, &MainWindow::spawnExternalPlayer);
     //  menu: directory
     connect(m_ui->actionSelect_next_file, &QAction::triggered, this, static_cast<void (MainWindow::*)(void)>(&MainWindow::selectNextFile));
     connect(m_ui->actionSelect_next_file_and_save_current, &QAction::triggered, m_ui->tagEditorWidget, &TagEditorWidget::saveAndShowNextFile);
+    connect(m_ui->actionSelect_next_incomplete_file, &QAction::triggered, this, &MainWindow::selectNextIncompleteFile);
     connect(m_ui->actionRename_files, &QAction::triggered, this, &MainWindow::showRenameFilesDlg);
+    connect(m_ui->actionEdit_selected_files, &QAction::triggered, this, &MainWindow::showBatchEditDlg);
     //  menu: help
     connect(m_ui->actionAbout, &QAction::triggered, this, &MainWindow::showAboutDlg);
     // tag editor widget
@@ -138,6 +144,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_ui->tagEditorWidget, &TagEditorWidget::fileStatusChanged, this, &MainWindow::handleFileStatusChange);
     connect(m_ui->tagEditorWidget, &TagEditorWidget::statusMessage, m_ui->statusBar, &QStatusBar::showMessage);
     connect(m_ui->tagEditorWidget, &TagEditorWidget::currentPathChanged, this, &MainWindow::handleCurrentPathChanged);
+    connect(m_ui->tagEditorWidget, &TagEditorWidget::fileShown, this, &MainWindow::prefetchNextFile);
     //  misc
     connect(m_ui->pathLineEdit, &QLineEdit::textEdited, this, &MainWindow::pathEntered);
     connect(m_ui->filesTreeView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &MainWindow::fileSelected);
@@ -229,6 +236,20 @@ bool MainWindow::event(QEvent *event)
             QMessageBox::warning(this, QCoreApplication::applicationName(), warning);
             return true;
         }
+        if (m_ui->tagEditorWidget->saveQueue().isBusy()) {
+            auto &saveQueue = m_ui->tagEditorWidget->saveQueue();
+            const auto pending = saveQueue.size();
+            if (QMessageBox::warning(this, QCoreApplication::applicationName(),
+                    tr("%1 file(s) are still being saved in the background. Do you want to abort saving and quit anyways?", nullptr,
+                        trQuandity(pending))
+                        .arg(pending),
+                    QMessageBox::Yes | QMessageBox::No, QMessageBox::No)
+                != QMessageBox::Yes) {
+                event->ignore();
+                return true;
+            }
+            saveQueue.abortAll();
+        }
 
         // save settings
         settings.mainWindow.geometry = saveGeometry();
@@ -407,6 +428,49 @@ void MainWindow::showRenameFilesDlg()
     }
 }
 
+/*!
+ * \brief Shows a BatchEditDialog for the files currently selected in the file browser.
+ * \remarks Selected directories and files which are currently saved by the tag editor are ignored. The file opened
+ *          within the tag editor is reloaded once the batch edit has been applied to it.
+ */
+void MainWindow::showBatchEditDlg()
+{
+    auto &editor = *m_ui->tagEditorWidget;
+    QStringList paths, skippedPaths;
+    for (const QModelIndex &index : m_ui->filesTreeView->selectionModel()->selectedRows()) {
+        const QString path(m_fileModel->filePath(m_fileFilterModel->mapToSource(index)));
+        if (!QFileInfo(path).isFile()) {
+            continue;
+        }
+        if (editor.saveQueue().contains(path) || (path == editor.currentPath() && editor.isFileOperationOngoing())) {
+            skippedPaths << path;
+        } else {
+            paths << path;
+        }
+    }
+    if (!skippedPaths.isEmpty()) {
+        QMessageBox::warning(this, QCoreApplication::applicationName(),
+            tr("The following file(s) are currently processed by the tag editor and will not be edited:\n%1").arg(skippedPaths.join(QChar('\n'))));
+    }
+    if (paths.isEmpty()) {
+        if (skippedPaths.isEmpty()) {
+            QMessageBox::information(this, QCoreApplication::applicationName(), tr("Select the files to be edited in the file browser first."));
+        }
+        return;
+    }
+    paths.sort();
+    auto *const dlg = new BatchEditDialog(paths, this);
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    connect(dlg, &BatchEditDialog::fileSaved, this, [this](const QString &path) {
+        // the tags shown within the editor are outdated; any further changes would be applied to the outdated structure
+        auto &editor = *m_ui->tagEditorWidget;
+        if (path == editor.currentPath() && !editor.isFileOperationOngoing()) {
+            editor.startParsing(path, true);
+        }
+    });
+    dlg->show();
+}
+
 /*!
  * \brief Selects the next file.
  * \remarks Does nothing if there is currently no file selected.
@@ -486,6 +550,57 @@ void MainWindow::selectNextFile(QItemSelectionModel *selectionModel, const QMode
     }
 }
 
+/*!
+ * \brief Parses the file following the currently shown file in advance so it can be shown immediately when selected.
+ * \remarks Only considers files within the same directory which have already been fetched by the file system model.
+ */
+void MainWindow::prefetchNextFile()
+{
+    if (!Settings::values().fileBrowser.prefetchNextFile) {
+        return;
+    }
+    const QModelIndex currentIndex = m_ui->filesTreeView->selectionModel()->currentIndex();
+    if (!currentIndex.isValid() || m_fileModel->filePath(m_fileFilterModel->mapToSource(currentIndex)) != m_ui->tagEditorWidget->currentPath()) {
+        return;
+    }
+    for (QModelIndex next = currentIndex.sibling(currentIndex.row() + 1, currentIndex.column()); next.isValid();
+         next = next.sibling(next.row() + 1, next.column())) {
+        const QModelIndex sourceIndex = m_fileFilterModel->mapToSource(next);
+        if (!m_fileModel->isDir(sourceIndex)) {
+            m_ui->tagEditorWidget->prefetchFile(m_fileModel->filePath(sourceIndex));
+            return;
+        }
+    }
+}
+
+/*!
+ * \brief Selects the next file within the current directory which needs work according to its tag status.
+ * \remarks Only considers files which have already been fetched and whose tag status has already been determined.
+ * \sa TagStatusFileSystemModel::isIncomplete()
+ */
+void MainWindow::selectNextIncompleteFile()
+{
+    QItemSelectionModel *const selectionModel = m_ui->filesTreeView->selectionModel();
+    const QModelIndex currentIndex = selectionModel->currentIndex();
+    QModelIndex next;
+    if (!currentIndex.isValid()) {
+        next = m_fileFilterModel->index(0, 0, m_ui->filesTreeView->rootIndex());
+    } else if (m_fileFilterModel->hasChildren(currentIndex)) {
+        next = m_fileFilterModel->index(0, 0, currentIndex);
+    } else {
+        next = currentIndex.sibling(currentIndex.row() + 1, 0);
+    }
+    for (; next.isValid(); next = next.sibling(next.row() + 1, 0)) {
+        if (m_fileModel->isIncomplete(m_fileFilterModel->mapToSource(next))) {
+            selectionModel->setCurrentIndex(next, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+            m_ui->filesTreeView->scrollTo(next);
+            return;
+        }
+    }
+    m_ui->statusBar->showMessage(tr("There are no further incomplete files within the current directory (or their tag status has not been "
+                                    "determined yet)."));
+}
+
 void MainWindow::showNextFileNotFound()
 {
     static const QString errormsg(tr("Unable to show the next file because it can't be found anymore."));
@@ -535,6 +650,13 @@ void MainWindow::applySettingsFromDialog()
     if (m_fileModel->isReadOnly() != settings.fileBrowser.readOnly) {
         m_fileModel->setReadOnly(settings.fileBrowser.readOnly);
     }
+    m_fileModel->setTagStatusShown(settings.fileBrowser.showTagStatus);
+    for (int column = TagStatusFileSystemModel::firstTagStatusColumn,
+             end = TagStatusFileSystemModel::firstTagStatusColumn + TagStatusFileSystemModel::tagStatusColumnCount;
+         column != end; ++column) {
+        m_ui->filesTreeView->setColumnHidden(column, !settings.fileBrowser.showTagStatus);
+    }
+    m_ui->actionSelect_next_incomplete_file->setEnabled(settings.fileBrowser.showTagStatus);
 }
 
 } // namespace QtGui
@@ -10,7 +10,6 @@
 #include <QByteArray>
 #include <QMainWindow>
 
-QT_FORWARD_DECLARE_CLASS(QFileSystemModel)
 QT_FORWARD_DECLARE_CLASS(QItemSelectionModel)
 
 #define TAGEDITOR_ENUM_CLASS enum class
@@ -31,6 +30,7 @@ class MainWindow;
 }
 
 class TagEditorWidget;
+class TagStatusFileSystemModel;
 class RenameFilesDialog;
 class DbQueryWidget;
 
@@ -62,7 +62,9 @@ private Q_SLOTS:
     void fileSelected();
     void selectNextFile();
     void selectNextFile(QItemSelectionModel *selectionModel, const QModelIndex &currentIndex, bool notDeeper);
+    void selectNextIncompleteFile();
     void showNextFileNotFound();
+    void prefetchNextFile();
     void showOpenFileDlg();
     void showSaveAsDlg();
     void handleFileStatusChange(bool opened, bool hasTag);
@@ -75,6 +77,7 @@ private Q_SLOTS:
     // misc
     void showAboutDlg();
     void showRenameFilesDlg();
+    void showBatchEditDlg();
     void spawnExternalPlayer();
     void initDbQueryWidget();
     void toggleDbQueryWidget();
@@ -86,7 +89,7 @@ private:
     // UI
     std::unique_ptr<Ui::MainWindow> m_ui;
     // models
-    QFileSystemModel *m_fileModel;
+    TagStatusFileSystemModel *m_fileModel;
     FileFilterProxyModel *m_fileFilterModel;
     bool m_internalFileSelection;
     // dialogs
@@ -15,8 +15,21 @@ using namespace Utility;
 
 namespace QtGui {
 
+/*!
+ * \class QtGui::DiagModel
+ * \brief The DiagModel class provides a list model for TagParser::Diagnostics.
+ *
+ * Messages can be filtered by their level and identical messages can be shown only once along with the number
+ * of occurrences.
+ */
+
+/*!
+ * \brief Constructs a new, empty model which shows all messages deduplicated.
+ */
 DiagModel::DiagModel(QObject *parent)
     : QAbstractListModel(parent)
+    , m_minLevel(DiagLevel::None)
+    , m_deduplicating(true)
 {
 }
 
@@ -54,7 +67,7 @@ int DiagModel::columnCount(const QModelIndex &parent) const
 int DiagModel::rowCount(const QModelIndex &parent) const
 {
     if (!parent.isValid()) {
-        return sizeToInt(m_diag.size());
+        return sizeToInt(m_rows.size());
     }
     return 0;
 }
@@ -66,30 +79,33 @@ Qt::ItemFlags DiagModel::flags(const QModelIndex &index) const
 
 QVariant DiagModel::data(const QModelIndex &index, int role) const
 {
-    if (index.isValid() && index.row() >= 0 && static_cast<std::size_t>(index.row()) < m_diag.size()) {
+    if (index.isValid() && index.row() >= 0 && static_cast<std::size_t>(index.row()) < m_rows.size()) {
+        const auto &msg = messageAt(index.row());
         switch (role) {
         case Qt::DisplayRole:
             switch (index.column()) {
             case 0: {
-                const string &context = m_diag[static_cast<std::size_t>(index.row())].context();
+                const string &context = msg.context();
                 if (context.empty()) {
                     return tr("unspecified");
                 } else {
                     return QString::fromUtf8(context.c_str());
                 }
             }
-            case 1:
-                return QString::fromUtf8(m_diag[static_cast<std::size_t>(index.row())].message().c_str());
+            case 1: {
+                const auto count = m_rows[static_cast<std::size_t>(index.row())].count;
+                const auto message = QString::fromUtf8(msg.message().c_str());
+                return count > 1 ? tr("%1 (%2 times)").arg(message).arg(count) : message;
+            }
             case 2:
-                return QString::fromUtf8(
-                    m_diag[static_cast<std::size_t>(index.row())].creationTime().toString(DateTimeOutputFormat::DateAndTime, true).c_str());
+                return QString::fromUtf8(msg.creationTime().toString(DateTimeOutputFormat::DateAndTime, true).c_str());
             default:;
             }
             break;
         case Qt::DecorationRole:
             switch (index.column()) {
             case 0:
-                switch (m_diag[static_cast<std::size_t>(index.row())].level()) {
+                switch (msg.level()) {
                 case DiagLevel::None:
                 case DiagLevel::Debug:
                     return debugIcon();
@@ -116,13 +132,91 @@ const Diagnostics &DiagModel::diagnostics() const
     return m_diag;
 }
 
-void DiagModel::setDiagnostics(const TagParser::Diagnostics &notifications)
+/*!
+ * \brief Assigns the specified \a diagnostics resetting the model.
+ */
+void DiagModel::setDiagnostics(const TagParser::Diagnostics &diagnostics)
 {
     beginResetModel();
-    m_diag = notifications;
+    m_diag = diagnostics;
+    buildRows();
     endResetModel();
 }
 
+/*!
+ * \brief Sets the minimum level of the messages to be shown.
+ */
+void DiagModel::setMinLevel(DiagLevel minLevel)
+{
+    if (m_minLevel == minLevel) {
+        return;
+    }
+    m_minLevel = minLevel;
+    rebuildRows();
+}
+
+/*!
+ * \brief Sets whether identical messages are shown only once (along with the number of occurrences).
+ */
+void DiagModel::setDeduplicating(bool deduplicating)
+{
+    if (m_deduplicating == deduplicating) {
+        return;
+    }
+    m_deduplicating = deduplicating;
+    rebuildRows();
+}
+
+/*!
+ * \brief Rebuilds all rows, e.g. when the filtering has changed.
+ */
+void DiagModel::rebuildRows()
+{
+    beginResetModel();
+    buildRows();
+    endResetModel();
+}
+
+/*!
+ * \brief Builds the rows for the messages (without emitting any signals).
+ *
+ * Messages with a level lower than minLevel() are skipped. When deduplicating, messages with the same level,
+ * context and text are counted within the row of the first occurrence.
+ */
+void DiagModel::buildRows()
+{
+    m_rows.clear();
+    m_rowsByMessage.clear();
+    string key;
+    for (std::size_t messageIndex = 0; messageIndex < m_diag.size(); ++messageIndex) {
+        const auto &msg = m_diag[messageIndex];
+        if (msg.level() < m_minLevel) {
+            continue;
+        }
+        if (m_deduplicating) {
+            key.clear();
+            key += static_cast<char>(msg.level());
+            key += msg.context();
+            key += '\0';
+            key += msg.message();
+            const auto [existingRow, inserted] = m_rowsByMessage.try_emplace(key, m_rows.size());
+            if (!inserted) {
+                ++m_rows[existingRow->second].count;
+                continue;
+            }
+        }
+        m_rows.emplace_back(Row{ messageIndex, 1 });
+    }
+}
+
+/*!
+ * \brief Returns the message shown in the specified \a row.
+ */
+const DiagMessage &DiagModel::messageAt(int row) const
+{
+    return m_diag[m_rows[static_cast<std::size_t>(row)].messageIndex];
+}
+
 const QIcon &DiagModel::informationIcon()
 {
     static const QIcon icon = QApplication::style()->standardIcon(QStyle::SP_MessageBoxInformation);
@@ -5,6 +5,10 @@
 
 #include <QAbstractListModel>
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace QtGui {
 
 class DiagModel : public QAbstractListModel {
@@ -20,20 +24,48 @@ public:
 
     const TagParser::Diagnostics &diagnostics() const;
     void setDiagnostics(const TagParser::Diagnostics &diagnostics);
+    TagParser::DiagLevel minLevel() const;
+    void setMinLevel(TagParser::DiagLevel minLevel);
+    bool isDeduplicating() const;
+    void setDeduplicating(bool deduplicating);
 
     static const QIcon &informationIcon();
     static const QIcon &warningIcon();
     static const QIcon &errorIcon();
     static const QIcon &debugIcon();
 
-Q_SIGNALS:
-
-public Q_SLOTS:
-
 private:
+    struct Row {
+        std::size_t messageIndex;
+        std::size_t count;
+    };
+    void rebuildRows();
+    void buildRows();
+    const TagParser::DiagMessage &messageAt(int row) const;
+
     TagParser::Diagnostics m_diag;
+    std::vector<Row> m_rows;
+    std::unordered_map<std::string, std::size_t> m_rowsByMessage;
+    TagParser::DiagLevel m_minLevel;
+    bool m_deduplicating;
 };
 
+/*!
+ * \brief Returns the minimum level of the messages to be shown.
+ */
+inline TagParser::DiagLevel DiagModel::minLevel() const
+{
+    return m_minLevel;
+}
+
+/*!
+ * \brief Returns whether identical messages are shown only once (along with the number of occurrences).
+ */
+inline bool DiagModel::isDeduplicating() const
+{
+    return m_deduplicating;
+}
+
 } // namespace QtGui
 
 #endif // NOTIFICATIONMODEL_H
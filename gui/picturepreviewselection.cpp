@@ -21,7 +21,9 @@
 #include <c++utilities/misc/traits.h>
 
 #include <QAction>
+#include <QCache>
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QCursor>
 #include <QDragEnterEvent>
 #include <QDropEvent>
@@ -37,6 +39,8 @@
 #include <QMessageBox>
 #include <QMimeData>
 #include <QStringBuilder>
+#include <QTimer>
+#include <QtConcurrent>
 #ifndef QT_NO_CLIPBOARD
 #include <QBuffer>
 #include <QClipboard>
@@ -55,6 +59,58 @@ using namespace QtUtilities;
 
 namespace QtGui {
 
+/// \cond
+
+/*!
+ * \brief Returns the cache for thumbnails of recently shown pictures.
+ *
+ * The cache is shared between all instances and only accessed from the GUI thread. The cost of an entry is
+ * the size of its thumbnail in KiB. Least recently used thumbnails are evicted first.
+ */
+static QCache<QByteArray, DecodedPicture> &thumbnailCache()
+{
+    static auto cache = QCache<QByteArray, DecodedPicture>(32 * 1024);
+    return cache;
+}
+
+/*!
+ * \brief Returns the key for caching the thumbnail of the specified picture \a data shown in the specified \a displaySize.
+ */
+static QByteArray thumbnailCacheKey(const char *data, std::size_t size, const QSize &displaySize)
+{
+    // use a cryptographic hash so different pictures (eg. of different tracks of an album) don't collide
+    const auto payload = QByteArray::fromRawData(data, static_cast<int>(size));
+    return QCryptographicHash::hash(payload, QCryptographicHash::Sha1) + ':' + QByteArray::number(static_cast<qulonglong>(size)) + ':'
+        + QByteArray::number(displaySize.width()) + 'x' + QByteArray::number(displaySize.height());
+}
+
+/*!
+ * \brief Decodes the picture from \a data or the file at \a path and downscales it to \a displaySize.
+ * \remarks Invoked within a worker thread so it must not access any widgets.
+ */
+static DecodedPicture decodePicture(DecodedPicture &&picture, const QByteArray &data, const QString &path, const QSize &displaySize)
+{
+    QImage img;
+    if (path.isEmpty()) {
+        img = QImage::fromData(data);
+    } else {
+        QFile file(path);
+        if (!file.open(QFile::ReadOnly)) {
+            picture.missing = true;
+            return move(picture);
+        }
+        img = QImage::fromData(file.readAll());
+        picture.fileSize = file.size();
+    }
+    picture.resolution = img.size();
+    if (!img.isNull()) {
+        picture.thumbnail = img.scaled(displaySize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return move(picture);
+}
+
+/// \endcond
+
 /*!
  * \brief Constructs a new PicturePreviewSelection for the specified \a tag and \a field.
  */
@@ -66,6 +122,7 @@ PicturePreviewSelection::PicturePreviewSelection(Tag *tag, KnownField field, QWi
     , m_textItem(nullptr)
     , m_pixmapItem(nullptr)
     , m_rectItem(nullptr)
+    , m_previewResizeTimer(new QTimer(this))
     , m_tag(tag)
     , m_field(field)
     , m_currentFileSize(0)
@@ -80,6 +137,14 @@ PicturePreviewSelection::PicturePreviewSelection(Tag *tag, KnownField field, QWi
     connect(m_ui->displayButton, &QPushButton::clicked, this, &PicturePreviewSelection::displaySelected);
     connect(m_ui->restoreButton, &QPushButton::clicked, std::bind(&PicturePreviewSelection::setup, this, PreviousValueHandling::Clear));
     connect(m_ui->previewGraphicsView, &QGraphicsView::customContextMenuRequested, this, &PicturePreviewSelection::showContextMenu);
+    connect(&m_previewWatcher, &QFutureWatcherBase::finished, this, &PicturePreviewSelection::showDecodedPreview);
+    m_previewResizeTimer->setSingleShot(true);
+    m_previewResizeTimer->setInterval(200);
+    connect(m_previewResizeTimer, &QTimer::timeout, this, [this] {
+        if (m_currentTypeIndex < m_values.size()) {
+            updatePreview(m_currentTypeIndex);
+        }
+    });
     setup();
     setAcceptDrops(true);
 }
@@ -653,7 +718,9 @@ void PicturePreviewSelection::changeEvent(QEvent *event)
 void PicturePreviewSelection::resizeEvent(QResizeEvent *)
 {
     if (m_pixmapItem && !m_pixmap.isNull()) {
+        // scale the current thumbnail for now; a thumbnail for the new size is created when resizing has stopped
         m_pixmapItem->setPixmap(m_pixmap.scaled(m_ui->previewGraphicsView->size(), Qt::KeepAspectRatio));
+        m_previewResizeTimer->start();
     }
 }
 
@@ -773,43 +840,87 @@ void PicturePreviewSelection::updatePreview(int index)
     }
     const auto &value = m_values[index];
     if (value.isEmpty()) {
+        m_previewWatcher.cancel();
+        m_pixmap = QPixmap();
         m_textItem->setVisible(true);
         m_textItem->setPlainText(tr("No image (of the selected type) attached."));
         m_pixmapItem->setVisible(false);
         m_ui->addButton->setText(tr("Add"));
     } else {
-        QImage img;
+        // show the thumbnail from the cache or decode the picture using another thread
+        const auto displaySize = m_ui->previewGraphicsView->size();
+        auto picture = DecodedPicture();
+        auto data = QByteArray();
+        auto path = QString();
         if (value.mimeType() == "-->") {
-            QFile file(Utility::stringToQString(value.toString(), value.dataEncoding()));
-            if (file.open(QFile::ReadOnly)) {
-                img = QImage::fromData(file.readAll());
-                updateSizeAndMimeType(static_cast<std::size_t>(file.size()), img.size(), QString());
-            } else {
-                m_textItem->setPlainText(tr("The attached image can't be found."));
-                m_textItem->setVisible(true);
-                m_pixmapItem->setVisible(false);
+            path = Utility::stringToQString(value.toString(), value.dataEncoding());
+        } else if (value.dataSize() < numeric_limits<int>::max()) {
+            picture.cacheKey = thumbnailCacheKey(value.dataPointer(), value.dataSize(), displaySize);
+            picture.fileSize = static_cast<qint64>(value.dataSize());
+            picture.mimeType = QString::fromStdString(value.mimeType());
+            if (const auto *const cachedPicture = thumbnailCache().object(picture.cacheKey)) {
+                m_previewWatcher.cancel();
+                showPreview(*cachedPicture);
+                m_ui->addButton->setText(tr("Change"));
+                m_rectItem->setRect(0, 0, m_ui->previewGraphicsView->width(), m_ui->previewGraphicsView->height());
                 return;
             }
-        } else if (value.dataSize() < numeric_limits<int>::max()) {
-            img = QImage::fromData(reinterpret_cast<const uchar *>(value.dataPointer()), static_cast<int>(value.dataSize()));
-            updateSizeAndMimeType(value.dataSize(), img.size(), QString::fromStdString(value.mimeType()));
+            data = QByteArray(value.dataPointer(), static_cast<int>(value.dataSize()));
         }
-        if (img.isNull()) {
-            m_pixmap = QPixmap();
-            m_textItem->setPlainText(tr("Unable to display attached image."));
+        if (m_pixmap.isNull()) {
+            m_textItem->setPlainText(tr("Loading preview ..."));
             m_textItem->setVisible(true);
             m_pixmapItem->setVisible(false);
-        } else {
-            m_textItem->setVisible(false);
-            m_pixmap = QPixmap::fromImage(img);
-            m_pixmapItem->setPixmap(m_pixmap.scaled(m_ui->previewGraphicsView->size(), Qt::KeepAspectRatio));
-            m_pixmapItem->setVisible(true);
         }
+        m_previewWatcher.setFuture(QtConcurrent::run(
+            [picture = move(picture), data = move(data), path = move(path), displaySize]() mutable { return decodePicture(move(picture), data, path, displaySize); }));
         m_ui->addButton->setText(tr("Change"));
     }
     m_rectItem->setRect(0, 0, m_ui->previewGraphicsView->width(), m_ui->previewGraphicsView->height());
 }
 
+/*!
+ * \brief Shows the picture which has been decoded using another thread and adds its thumbnail to the cache.
+ */
+void PicturePreviewSelection::showDecodedPreview()
+{
+    if (m_previewWatcher.isCanceled()) {
+        return;
+    }
+    const auto picture = m_previewWatcher.result();
+    if (!picture.cacheKey.isEmpty() && !picture.thumbnail.isNull()) {
+        const auto cost = static_cast<int>(static_cast<qint64>(picture.thumbnail.bytesPerLine()) * picture.thumbnail.height() / 1024);
+        thumbnailCache().insert(picture.cacheKey, new DecodedPicture(picture), max(cost, 1));
+    }
+    showPreview(picture);
+}
+
+/*!
+ * \brief Shows the specified \a picture within the graphics view.
+ */
+void PicturePreviewSelection::showPreview(const DecodedPicture &picture)
+{
+    if (picture.missing) {
+        m_pixmap = QPixmap();
+        m_textItem->setPlainText(tr("The attached image can't be found."));
+        m_textItem->setVisible(true);
+        m_pixmapItem->setVisible(false);
+        return;
+    }
+    updateSizeAndMimeType(static_cast<std::size_t>(picture.fileSize), picture.resolution, picture.mimeType);
+    if (picture.thumbnail.isNull()) {
+        m_pixmap = QPixmap();
+        m_textItem->setPlainText(tr("Unable to display attached image."));
+        m_textItem->setVisible(true);
+        m_pixmapItem->setVisible(false);
+    } else {
+        m_textItem->setVisible(false);
+        m_pixmap = QPixmap::fromImage(picture.thumbnail);
+        m_pixmapItem->setPixmap(m_pixmap);
+        m_pixmapItem->setVisible(true);
+    }
+}
+
 void PicturePreviewSelection::showContextMenu(const QPoint &position)
 {
     QMenu menu;
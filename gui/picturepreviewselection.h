@@ -5,6 +5,8 @@
 
 #include <tagparser/tag.h>
 
+#include <QFutureWatcher>
+#include <QImage>
 #include <QSize>
 #include <QWidget>
 
@@ -15,6 +17,7 @@ QT_FORWARD_DECLARE_CLASS(QGraphicsScene)
 QT_FORWARD_DECLARE_CLASS(QGraphicsTextItem)
 QT_FORWARD_DECLARE_CLASS(QGraphicsPixmapItem)
 QT_FORWARD_DECLARE_CLASS(QGraphicsRectItem)
+QT_FORWARD_DECLARE_CLASS(QTimer)
 
 #define TAGEDITOR_ENUM_CLASS enum class
 namespace TagParser {
@@ -33,6 +36,18 @@ class PicturePreviewSelection;
 class ImageConversionDialog;
 } // namespace Ui
 
+/*!
+ * \brief The DecodedPicture struct holds a picture which has been decoded and downscaled for the preview.
+ */
+struct DecodedPicture {
+    QByteArray cacheKey;
+    QImage thumbnail;
+    QSize resolution;
+    qint64 fileSize = 0;
+    QString mimeType;
+    bool missing = false;
+};
+
 class PicturePreviewSelection : public QWidget {
     Q_OBJECT
 
@@ -78,11 +93,13 @@ private Q_SLOTS:
     void updateDescription(int newIndex);
     void updateDescription(int lastIndex, int newIndex);
     void updatePreview(int index);
+    void showDecodedPreview();
     void showContextMenu(const QPoint &position);
 
 private:
     bool setup(PreviousValueHandling previousValueHandling = PreviousValueHandling::Clear);
     void updateSizeAndMimeType(std::size_t fileSize, const QSize &resolution, const QString &mimeType);
+    void showPreview(const DecodedPicture &picture);
     QImage convertTagValueToImage(const TagParser::TagValue &value);
     void assignImageToTagValue(const QImage &image, TagParser::TagValue &tagValue, const char *format);
 
@@ -94,6 +111,8 @@ private:
     QPixmap m_pixmap;
     QGraphicsPixmapItem *m_pixmapItem;
     QGraphicsRectItem *m_rectItem;
+    QFutureWatcher<DecodedPicture> m_previewWatcher;
+    QTimer *m_previewResizeTimer;
     TagParser::Tag *m_tag;
     TagParser::KnownField m_field;
     QList<TagParser::TagValue> m_values;
@@ -1,4 +1,5 @@
 #include "./renamefilesdialog.h"
+#include "./filewatcher.h"
 #include "./javascripthighlighter.h"
 
 #include "../renamingutility/filesystemitem.h"
@@ -34,6 +35,7 @@ RenameFilesDialog::RenameFilesDialog(QWidget *parent)
     , m_errorsOccured(0)
     , m_changingSelection(false)
     , m_scriptModified(false)
+    , m_previewOutdated(false)
 {
     setAttribute(Qt::WA_QuitOnClose, false);
     m_ui->setupUi(this);
@@ -69,9 +71,10 @@ RenameFilesDialog::RenameFilesDialog(QWidget *parent)
     // restore settings
     const auto &settings = Settings::values().renamingUtility;
     if (Settings::values().renamingUtility.scriptSource < m_ui->sourceFileStackedWidget->count()) {
-        m_ui->sourceFileStackedWidget->setCurrentIndex(settings.scriptSource);
+        setScriptSource(settings.scriptSource);
     }
     m_ui->scriptFilePathLineEdit->setText(settings.externalScript);
+    m_ui->templateLineEdit->setText(settings.templateString);
     if (!Settings::values().renamingUtility.editorScript.isEmpty()) {
         m_ui->javaScriptPlainTextEdit->setPlainText(settings.editorScript);
         m_scriptModified = true;
@@ -93,10 +96,15 @@ RenameFilesDialog::RenameFilesDialog(QWidget *parent)
     connect(m_ui->toggleScriptSourcePushButton, &QPushButton::clicked, this, &RenameFilesDialog::toggleScriptSource);
     connect(m_ui->selectScriptFilePushButton, &QPushButton::clicked, this, &RenameFilesDialog::showScriptFileSelectionDlg);
     connect(m_ui->javaScriptPlainTextEdit, &QPlainTextEdit::undoAvailable, this, &RenameFilesDialog::setScriptModified);
+    auto &fileWatcher = FileWatcher::instance();
+    connect(&fileWatcher, &FileWatcher::fileChanged, this, &RenameFilesDialog::markPreviewOutdated);
+    connect(&fileWatcher, &FileWatcher::fileRemoved, this, &RenameFilesDialog::markPreviewOutdated);
+    connect(&fileWatcher, &FileWatcher::directoryChanged, this, &RenameFilesDialog::markPreviewOutdated);
 }
 
 RenameFilesDialog::~RenameFilesDialog()
 {
+    watchDirectory(QString());
 }
 
 QString RenameFilesDialog::directory() const
@@ -117,6 +125,7 @@ bool RenameFilesDialog::event(QEvent *event)
         // save settings
         settings.scriptSource = m_ui->sourceFileStackedWidget->currentIndex();
         settings.externalScript = m_ui->scriptFilePathLineEdit->text();
+        settings.templateString = m_ui->templateLineEdit->text();
         if (m_scriptModified) {
             settings.editorScript = m_ui->javaScriptPlainTextEdit->toPlainText();
         } else {
@@ -143,7 +152,26 @@ void RenameFilesDialog::startGeneratingPreview()
     }
     QDir selectedDir(directory());
     m_ui->notificationLabel->setHidden(false);
-    if (selectedDir.exists()) {
+    if (selectedDir.exists() && m_ui->sourceFileStackedWidget->currentIndex() == 2) {
+        // use template
+        const auto format = m_ui->templateLineEdit->text();
+        if (format.isEmpty()) {
+            m_engine->clearPreview();
+            m_ui->notificationLabel->setText(tr("The template is empty."));
+            m_ui->notificationLabel->setNotificationType(NotificationType::Warning);
+        } else if (m_engine->setTemplate(format)) {
+            m_ui->notificationLabel->setText(tr("Generating preview ..."));
+            m_ui->notificationLabel->setNotificationType(NotificationType::Progress);
+            m_ui->abortClosePushButton->setText(tr("Abort"));
+            m_ui->generatePreviewPushButton->setHidden(true);
+            m_ui->applyChangingsPushButton->setHidden(true);
+            m_engine->generatePreview(directory(), m_ui->includeSubdirsCheckBox->isChecked());
+        } else {
+            m_engine->clearPreview();
+            m_ui->notificationLabel->setText(tr("The template is not valid: %1").arg(m_engine->errorMessage()));
+            m_ui->notificationLabel->setNotificationType(NotificationType::Warning);
+        }
+    } else if (selectedDir.exists()) {
         QString program;
         if (m_ui->sourceFileStackedWidget->currentIndex() == 0) {
             program = m_ui->javaScriptPlainTextEdit->toPlainText();
@@ -203,6 +231,8 @@ void RenameFilesDialog::startApplyChangings()
     m_ui->abortClosePushButton->setText(tr("Abort"));
     m_ui->generatePreviewPushButton->setHidden(true);
     m_ui->applyChangingsPushButton->setHidden(true);
+    // stop watching the directory; the changes are applied by the engine itself
+    watchDirectory(QString());
     m_engine->applyChangings();
 }
 
@@ -223,12 +253,15 @@ void RenameFilesDialog::showPreviewResults()
     m_ui->abortClosePushButton->setText(tr("Close"));
     m_ui->generatePreviewPushButton->setHidden(false);
     m_ui->applyChangingsPushButton->setHidden(false);
+    m_previewOutdated = false;
     if (m_engine->rootItem()) {
+        watchDirectory(m_engine->rootDirectory().absolutePath());
         m_ui->notificationLabel->setText(tr("Preview has been generated."));
         m_ui->notificationLabel->appendLine(tr("%1 files/directories have been processed.", nullptr, m_itemsProcessed).arg(m_itemsProcessed));
         m_ui->notificationLabel->setNotificationType(NotificationType::Information);
         m_ui->applyChangingsPushButton->setEnabled(true);
     } else {
+        watchDirectory(QString());
         m_ui->notificationLabel->setText(tr("No files and directories have been found."));
         m_ui->notificationLabel->setNotificationType(NotificationType::Warning);
         m_ui->applyChangingsPushButton->setEnabled(false);
@@ -261,6 +294,42 @@ void RenameFilesDialog::showChangsingsResults()
     }
 }
 
+/*!
+ * \brief Marks the preview as outdated if the file or directory at the specified \a path is within the previewed directory.
+ * \remarks This slot is connected to the signals of the FileWatcher. Applying the outdated preview is prevented because
+ *          the files it refers to might not exist anymore or have different tags by now.
+ */
+void RenameFilesDialog::markPreviewOutdated(const QString &path)
+{
+    if (m_previewOutdated || m_watchedDirectory.isEmpty() || m_engine->isBusy()
+        || (path != m_watchedDirectory && !path.startsWith(m_watchedDirectory + QChar('/')))) {
+        return;
+    }
+    m_previewOutdated = true;
+    m_ui->applyChangingsPushButton->setEnabled(false);
+    m_ui->notificationLabel->appendLine(tr("Files within the directory have been changed in the meantime. Generate the preview again to apply changings."));
+    m_ui->notificationLabel->setNotificationType(NotificationType::Warning);
+}
+
+/*!
+ * \brief Watches the specified \a directory using the FileWatcher instead of the previously watched directory.
+ * \remarks Only the directory itself is watched and not its subdirectories. An empty \a directory stops watching.
+ */
+void RenameFilesDialog::watchDirectory(const QString &directory)
+{
+    const auto cleanDirectory = QDir::cleanPath(directory);
+    if (m_watchedDirectory == cleanDirectory) {
+        return;
+    }
+    auto &fileWatcher = FileWatcher::instance();
+    if (!m_watchedDirectory.isEmpty()) {
+        fileWatcher.unwatchDirectory(m_watchedDirectory);
+    }
+    if (!(m_watchedDirectory = cleanDirectory).isEmpty()) {
+        fileWatcher.watchDirectory(m_watchedDirectory);
+    }
+}
+
 void RenameFilesDialog::currentItemSelected(const QItemSelection &, const QItemSelection &)
 {
     if (m_changingSelection) {
@@ -371,23 +440,27 @@ void RenameFilesDialog::showTreeViewContextMenu(const QPoint &position)
 
 void RenameFilesDialog::toggleScriptSource()
 {
-    int nextIndex;
-    switch (m_ui->sourceFileStackedWidget->currentIndex()) {
-    case 0:
-        nextIndex = 1;
-        break;
-    default:
-        nextIndex = 0;
-    }
-    m_ui->sourceFileStackedWidget->setCurrentIndex(nextIndex);
-    switch (nextIndex) {
+    setScriptSource((m_ui->sourceFileStackedWidget->currentIndex() + 1) % m_ui->sourceFileStackedWidget->count());
+}
+
+/*!
+ * \brief Shows the page for the specified \a scriptSource (0: editor, 1: external file, 2: template) and updates the buttons accordingly.
+ */
+void RenameFilesDialog::setScriptSource(int scriptSource)
+{
+    m_ui->sourceFileStackedWidget->setCurrentIndex(scriptSource);
+    switch (scriptSource) {
     case 0:
         m_ui->pasteScriptPushButton->setVisible(true);
-        m_ui->toggleScriptSourcePushButton->setText("Use external file");
+        m_ui->toggleScriptSourcePushButton->setText(tr("Use external file"));
+        break;
+    case 1:
+        m_ui->pasteScriptPushButton->setVisible(false);
+        m_ui->toggleScriptSourcePushButton->setText(tr("Use template"));
         break;
     default:
         m_ui->pasteScriptPushButton->setVisible(false);
-        m_ui->toggleScriptSourcePushButton->setText("Use editor");
+        m_ui->toggleScriptSourcePushButton->setText(tr("Use editor"));
     }
 }
 
@@ -51,15 +51,21 @@ private Q_SLOTS:
     void abortClose();
     void toggleScriptSource();
     void setScriptModified(bool scriptModified);
+    void markPreviewOutdated(const QString &path);
 
 private:
+    void watchDirectory(const QString &directory);
+    void setScriptSource(int scriptSource);
+
     std::unique_ptr<Ui::RenameFilesDialog> m_ui;
     JavaScriptHighlighter *m_highlighter;
     RenamingUtility::RenamingEngine *m_engine;
+    QString m_watchedDirectory;
     int m_itemsProcessed;
     int m_errorsOccured;
     bool m_changingSelection;
     bool m_scriptModified;
+    bool m_previewOutdated;
 };
 
 } // namespace QtGui
@@ -0,0 +1,188 @@
+#include "./savequeue.h"
+
+#include <tagparser/abortableprogressfeedback.h>
+#include <tagparser/exceptions.h>
+
+#include <c++utilities/conversion/stringbuilder.h>
+
+#include <QtConcurrent>
+
+using namespace std;
+using namespace CppUtilities;
+using namespace TagParser;
+
+namespace QtGui {
+
+/*!
+ * \class QtGui::SaveQueue
+ * \brief The SaveQueue class saves files one after another using another thread.
+ *
+ * The TagEditorWidget hands over the MediaFileInfo of the current file after the entered values have been
+ * applied to its tags. This way the edited tag state is kept by the queue and the editor can go on with
+ * the next file immediately while a possibly long-lasting rewrite of the previous file is still ongoing.
+ */
+
+/*!
+ * \brief Constructs a new, empty save queue.
+ */
+SaveQueue::SaveQueue(QObject *parent)
+    : QObject(parent)
+    , m_abortCurrent(false)
+{
+    connect(&m_watcher, &QFutureWatcherBase::finished, this, &SaveQueue::handleCurrentItemFinished);
+}
+
+/*!
+ * \brief Destroys the queue waiting for the file which is currently saved.
+ * \remarks Files which are still waiting to be saved are discarded so the user should be asked before.
+ */
+SaveQueue::~SaveQueue()
+{
+    m_watcher.waitForFinished();
+}
+
+/*!
+ * \brief Adds the specified \a fileInfo to the queue.
+ * \param path Specifies the path of the file as shown to the user.
+ * \param fileInfo Specifies the file to be saved; the changes must have been applied to its tags already.
+ * \param diag Specifies the diagnostic messages gathered so far (parsing, applying entries).
+ */
+void SaveQueue::enqueue(const QString &path, std::unique_ptr<MediaFileInfo> &&fileInfo, Diagnostics &&diag)
+{
+    m_items.emplace_back();
+    auto &item = m_items.back();
+    item.path = path;
+    item.fileInfo = move(fileInfo);
+    item.diag = move(diag);
+    if (m_items.size() == 1) {
+        emit busyChanged(true);
+        startNext();
+    }
+}
+
+/*!
+ * \brief Returns whether the file with the specified \a path is currently saved or waiting to be saved.
+ */
+bool SaveQueue::contains(const QString &path) const
+{
+    for (const auto &item : m_items) {
+        if (item.path == path) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief Aborts saving the current file and discards all files which are waiting to be saved.
+ */
+void SaveQueue::abortAll()
+{
+    if (m_items.empty()) {
+        return;
+    }
+    m_abortCurrent = true;
+    while (m_items.size() > 1) {
+        const auto path = m_items.back().path;
+        m_items.pop_back();
+        emit fileSaved(path, tr("Saving \"%1\" has been canceled.").arg(path), true);
+    }
+}
+
+/*!
+ * \brief Starts saving the file at the front of the queue.
+ */
+void SaveQueue::startNext()
+{
+    m_abortCurrent = false;
+    auto &item = m_items.front();
+    m_watcher.setFuture(QtConcurrent::run([this, &item] { saveItem(item); }));
+}
+
+/*!
+ * \brief Applies the changes of the specified \a item.
+ * \remarks Runs within the thread started by startNext().
+ */
+void SaveQueue::saveItem(Item &item)
+{
+    const auto showProgress = [this, &item](AbortableProgressFeedback &progress) {
+        if (m_abortCurrent.load()) {
+            progress.tryToAbort();
+            return;
+        }
+        emit progressChanged(item.path, QString::fromStdString(progress.step()), progress.stepPercentage());
+    };
+    AbortableProgressFeedback progress(showProgress, showProgress);
+    try {
+        try {
+            item.fileInfo->applyChanges(item.diag, progress);
+        } catch (const OperationAbortedException &) {
+            item.canceled = true;
+        } catch (const Failure &) {
+            item.processingError = true;
+        } catch (const std::ios_base::failure &) {
+            item.ioError = true;
+        }
+    } catch (const exception &e) {
+        item.diag.emplace_back(TagParser::DiagLevel::Critical, argsToString("Something completely unexpected happened: ", e.what()), "making");
+        item.processingError = true;
+    } catch (...) {
+        item.diag.emplace_back(TagParser::DiagLevel::Critical, "Something completely unexpected happened", "making");
+        item.processingError = true;
+    }
+    item.fileInfo->close();
+}
+
+/*!
+ * \brief Reports the result of the file which has just been saved and starts saving the next file.
+ */
+void SaveQueue::handleCurrentItemFinished()
+{
+    if (m_items.empty()) {
+        return;
+    }
+    const auto item = move(m_items.front());
+    m_items.pop_front();
+
+    // go on with the next file
+    if (m_items.empty()) {
+        emit busyChanged(false);
+    } else {
+        startNext();
+    }
+
+    // report the result
+    size_t critical = 0, warnings = 0;
+    QString firstCriticalMessage;
+    for (const auto &msg : item.diag) {
+        switch (msg.level()) {
+        case TagParser::DiagLevel::Fatal:
+        case TagParser::DiagLevel::Critical:
+            if (!critical++) {
+                firstCriticalMessage = QString::fromStdString(msg.message());
+            }
+            break;
+        case TagParser::DiagLevel::Warning:
+            ++warnings;
+            break;
+        default:;
+        }
+    }
+    if (item.ioError) {
+        emit fileSaved(item.path, tr("The tags of \"%1\" could not be saved because an IO error occured.").arg(item.path), true);
+    } else if (item.processingError) {
+        emit fileSaved(item.path, tr("The tags of \"%1\" could not be saved: %2").arg(item.path, firstCriticalMessage), true);
+    } else if (item.canceled) {
+        emit fileSaved(item.path, tr("Saving \"%1\" has been canceled.").arg(item.path), true);
+    } else if (critical) {
+        emit fileSaved(item.path,
+            tr("The tags of \"%1\" have been saved, but there is/are %2 error(s): %3").arg(item.path).arg(critical).arg(firstCriticalMessage),
+            true);
+    } else if (warnings) {
+        emit fileSaved(item.path, tr("The tags of \"%1\" have been saved, but there is/are %2 warning(s).").arg(item.path).arg(warnings), false);
+    } else {
+        emit fileSaved(item.path, tr("The tags of \"%1\" have been saved.").arg(item.path), false);
+    }
+}
+
+} // namespace QtGui
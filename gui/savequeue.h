@@ -0,0 +1,80 @@
+#ifndef SAVEQUEUE_H
+#define SAVEQUEUE_H
+
+#include <tagparser/diagnostics.h>
+#include <tagparser/mediafileinfo.h>
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+namespace QtGui {
+
+class SaveQueue : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+
+public:
+    explicit SaveQueue(QObject *parent = nullptr);
+    ~SaveQueue() override;
+
+    void enqueue(const QString &path, std::unique_ptr<TagParser::MediaFileInfo> &&fileInfo, TagParser::Diagnostics &&diag);
+    bool isBusy() const;
+    std::size_t size() const;
+    bool contains(const QString &path) const;
+
+public Q_SLOTS:
+    void abortAll();
+
+Q_SIGNALS:
+    /// \brief Emitted when the queue becomes busy or idle.
+    void busyChanged(bool busy);
+    /// \brief Emitted when the progress of the file which is currently saved changes.
+    /// \remarks Emitted from the thread which saves the file.
+    void progressChanged(const QString &path, const QString &step, int percentage);
+    /// \brief Emitted when a file has been saved, could not be saved or saving has been canceled.
+    void fileSaved(const QString &path, const QString &message, bool failed);
+
+private Q_SLOTS:
+    void handleCurrentItemFinished();
+
+private:
+    struct Item {
+        QString path;
+        std::unique_ptr<TagParser::MediaFileInfo> fileInfo;
+        TagParser::Diagnostics diag;
+        bool processingError = false;
+        bool ioError = false;
+        bool canceled = false;
+    };
+    void startNext();
+    void saveItem(Item &item);
+
+    std::deque<Item> m_items;
+    QFutureWatcher<void> m_watcher;
+    std::atomic<bool> m_abortCurrent;
+};
+
+/*!
+ * \brief Returns whether files are currently saved (or waiting to be saved).
+ */
+inline bool SaveQueue::isBusy() const
+{
+    return !m_items.empty();
+}
+
+/*!
+ * \brief Returns the number of files which are currently saved or waiting to be saved.
+ */
+inline std::size_t SaveQueue::size() const
+{
+    return m_items.size();
+}
+
+} // namespace QtGui
+
+#endif // SAVEQUEUE_H
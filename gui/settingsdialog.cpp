@@ -53,6 +53,8 @@ bool FileBrowserGeneralOptionPage::apply()
     if (hasBeenShown()) {
         settings.hideBackupFiles = ui()->hideBackupFilesCheckBox->isChecked();
         settings.readOnly = ui()->readOnlyCheckBox->isChecked();
+        settings.prefetchNextFile = ui()->prefetchNextFileCheckBox->isChecked();
+        settings.showTagStatus = ui()->showTagStatusCheckBox->isChecked();
     }
     return true;
 }
@@ -63,6 +65,8 @@ void FileBrowserGeneralOptionPage::reset()
     if (hasBeenShown()) {
         ui()->hideBackupFilesCheckBox->setChecked(settings.hideBackupFiles);
         ui()->readOnlyCheckBox->setChecked(settings.readOnly);
+        ui()->prefetchNextFileCheckBox->setChecked(settings.prefetchNextFile);
+        ui()->showTagStatusCheckBox->setChecked(settings.showTagStatus);
     }
 }
 
@@ -93,6 +97,7 @@ bool EditorGeneralOptionPage::apply()
             settings.multipleTagHandling = MultipleTagHandling::SeparateEditors;
         }
         settings.saveAndShowNextOnEnter = ui()->nextWhenPressingEnterCheckBox->isChecked();
+        settings.saveInBackground = ui()->saveInBackgroundCheckBox->isChecked();
         settings.askBeforeDeleting = ui()->askBeforeDeletingCheckBox->isChecked();
         settings.hideTagSelectionComboBox = ui()->hideTagSelectionComboBoxCheckBox->isChecked();
         settings.hideCoverButtons = ui()->hideCoverButtonsCheckBox->isChecked();
@@ -124,6 +129,7 @@ void EditorGeneralOptionPage::reset()
             break;
         }
         ui()->nextWhenPressingEnterCheckBox->setChecked(settings.saveAndShowNextOnEnter);
+        ui()->saveInBackgroundCheckBox->setChecked(settings.saveInBackground);
         ui()->askBeforeDeletingCheckBox->setChecked(settings.askBeforeDeleting);
         ui()->hideTagSelectionComboBoxCheckBox->setChecked(settings.hideTagSelectionComboBox);
         ui()->hideCoverButtonsCheckBox->setChecked(settings.hideCoverButtons);
@@ -23,6 +23,10 @@ namespace QtGui {
 /*!
  * \class QtGui::TagEdit
  * \brief The TagEdit widget allows the user to edit TagParser::Tag objects.
+ *
+ * A TagFieldEdit which is not required for the currently assigned tags is only hidden and kept
+ * in a pool. This way switching between files of different formats does not require re-creating
+ * widgets and re-building the layout.
  */
 
 /*!
@@ -264,12 +268,13 @@ void TagEdit::apply()
  */
 void TagEdit::invalidate()
 {
-    // remove current widgets
-    for (QWidget *const edit : m_widgets) {
+    // remove current widgets (including pooled ones)
+    for (QWidget *const edit : m_pooledWidgets) {
         removeEdit(edit);
         edit->deleteLater();
     }
     m_widgets.clear();
+    m_pooledWidgets.clear();
     // recreate widgets
     setupUi();
 }
@@ -279,7 +284,7 @@ void TagEdit::invalidate()
  */
 void TagEdit::setCoverButtonsHidden(bool hideCoverButtons)
 {
-    for (auto i = m_widgets.begin(), end = m_widgets.end(); i != end; ++i) {
+    for (auto i = m_pooledWidgets.begin(), end = m_pooledWidgets.end(); i != end; ++i) {
         i.value()->setCoverButtonsHidden(hideCoverButtons);
     }
 }
@@ -290,38 +295,32 @@ void TagEdit::setCoverButtonsHidden(bool hideCoverButtons)
 void TagEdit::setupUi()
 {
     setUpdatesEnabled(false);
+    m_widgets.clear();
     if (m_tags.empty()) {
-        // there are no tags assigned -> remove all editing controls
-        for (QWidget *const edit : m_widgets) {
-            removeEdit(edit);
-            edit->deleteLater();
+        // there are no tags assigned -> hide all editing controls
+        for (TagFieldEdit *const edit : m_pooledWidgets) {
+            setEditVisible(edit, false);
         }
-        m_widgets.clear();
         setUpdatesEnabled(true);
         return;
     }
 
     // there are tags assigned
-    // setup editing controls
+    // setup editing controls; the rows of hidden edits are kept so their positions need to be taken into account
     TagFieldEdit *edit = nullptr;
-    int rowOverall = 0, rowLeft = 0, rowRight = 0;
+    int rowLeft = 0, rowRight = 0;
     for (const auto &item : Settings::values().editor.fields.items()) {
-        KnownField field = static_cast<KnownField>(item.id().toInt());
-        if (!item.isChecked() || !hasField(field)) {
+        const auto field = static_cast<KnownField>(item.id().toInt());
+        const auto required = item.isChecked() && hasField(field);
+        edit = m_pooledWidgets.value(field, nullptr);
+        if (!edit && !required) {
             // the field is either disabled or it is not supported by at least one of the assigned tags
-            if ((edit = m_widgets.value(field))) {
-                m_widgets.remove(field);
-                removeEdit(edit);
-                edit->deleteLater();
-            }
             continue;
         }
 
-        // the field is not disabled and the field is supported by at least one of the assigned tags
-        edit = m_widgets.value(field, nullptr);
         if (edit) {
-            // we have already an edit for the field -> try to recycle it
-            // the order might have changed
+            // we have already an edit for the field -> recycle it
+            // the order might have changed (only if the settings have been altered)
             int prevIndex; // stores the previous index (NOT row)
             switch (field) {
             case KnownField::Cover:
@@ -351,8 +350,11 @@ void TagEdit::setupUi()
                     m_layoutLeft->insertRow(rowLeft, label, edit);
                 }
             }
-            // update the tag field
-            edit->setTagField(m_tags, field, m_previousValueHandling);
+            if (required) {
+                // update the tag field
+                edit->setTagField(m_tags, field, m_previousValueHandling);
+            }
+            setEditVisible(edit, required);
         } else {
             // we need to create a new edit for the field
             edit = new TagFieldEdit(m_tags, field, this);
@@ -369,11 +371,13 @@ void TagEdit::setupUi()
                 // editing widgets for the other fields will be show at the left side (m_layoutLeft)
                 m_layoutLeft->insertRow(rowLeft, item.label(), edit);
             }
+            m_pooledWidgets.insert(field, edit);
+        }
+        if (required) {
             m_widgets.insert(field, edit);
         }
         // update the current position
         // note: The position is required to keep the order of Settings::fieldModel().fields().
-        ++rowOverall;
         switch (field) {
         case KnownField::Cover:
         case KnownField::Lyrics:
@@ -409,6 +413,33 @@ void TagEdit::removeEdit(QWidget *edit)
     m_layoutRight->removeWidget(item->widget());
 }
 
+/*!
+ * \brief Internally called to show or hide an \a edit and its label.
+ * \remarks Hidden edits are kept within the layout so they can be shown again without re-building the layout.
+ */
+void TagEdit::setEditVisible(TagFieldEdit *edit, bool visible)
+{
+    if (edit->isVisibleTo(this) == visible) {
+        return;
+    }
+    edit->setVisible(visible);
+    // the left layout might contain the label
+    if (QWidget *const label = m_layoutLeft->labelForField(edit)) {
+        label->setVisible(visible);
+        return;
+    }
+    // or the right layout might contain the label
+    const auto i = m_layoutRight->indexOf(edit) - 1;
+    if (i < 0) {
+        return;
+    }
+    if (QLayoutItem *const item = m_layoutRight->itemAt(i)) {
+        if (QWidget *const label = item->widget()) {
+            label->setVisible(visible);
+        }
+    }
+}
+
 /*!
  * \brief Internlly called to assign tags without updating the UI.
  */
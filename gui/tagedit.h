@@ -61,12 +61,14 @@ Q_SIGNALS:
 private:
     void setupUi();
     void removeEdit(QWidget *edit);
+    void setEditVisible(TagFieldEdit *edit, bool visible);
     void assignTags();
 
     QList<TagParser::Tag *> m_tags;
     QFormLayout *m_layoutLeft;
     QVBoxLayout *m_layoutRight;
     QMap<TagParser::KnownField, TagFieldEdit *> m_widgets;
+    QMap<TagParser::KnownField, TagFieldEdit *> m_pooledWidgets;
     PreviousValueHandling m_previousValueHandling;
 };
 
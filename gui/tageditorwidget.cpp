@@ -2,7 +2,9 @@
 #include "./attachmentsedit.h"
 #include "./entertargetdialog.h"
 #include "./fileinfomodel.h"
+#include "./filewatcher.h"
 #include "./notificationlabel.h"
+#include "./savequeue.h"
 #include "./tagedit.h"
 #include "./webviewincludes.h"
 
@@ -38,7 +40,6 @@
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFileSystemModel>
-#include <QFileSystemWatcher>
 #include <QGuiApplication>
 #include <QHeaderView>
 #include <QKeyEvent>
@@ -65,7 +66,42 @@ using namespace Utility;
 
 namespace QtGui {
 
-enum LoadingResult : char { ParsingSuccessful, FatalParsingError, IoError };
+enum LoadingResult : char { ParsingSuccessful, FatalParsingError, IoError, ParsingOngoing };
+
+/*!
+ * \brief Opens and parses the specified \a fileInfo.
+ * \remarks This function is supposed to be called from a worker thread.
+ */
+static LoadingResult parseFile(MediaFileInfo &fileInfo, Diagnostics &diag, bool forceFullParse)
+{
+    try { // credits for this nesting go to GCC regression 66145
+        try {
+            // try to open with write access
+            try {
+                fileInfo.reopen(false);
+            } catch (const std::ios_base::failure &) {
+                // try to open read-only if opening with write access failed
+                fileInfo.reopen(true);
+            }
+            fileInfo.setForceFullParse(forceFullParse);
+            fileInfo.parseEverything(diag);
+            return ParsingSuccessful;
+        } catch (const Failure &) {
+            // the file has been opened; parsing notifications will be shown in the info box
+            return FatalParsingError;
+        } catch (const std::ios_base::failure &) {
+            // the file could not be opened because an IO error occured
+            fileInfo.close(); // ensure file is closed
+            return IoError;
+        }
+    } catch (const exception &e) {
+        diag.emplace_back(TagParser::DiagLevel::Critical, argsToString("Something completely unexpected happened: ", +e.what()), "parsing");
+        return FatalParsingError;
+    } catch (...) {
+        diag.emplace_back(TagParser::DiagLevel::Critical, "Something completely unexpected happened", "parsing");
+        return FatalParsingError;
+    }
+}
 
 /*!
  * \class QtGui::TagEditorWidget
@@ -85,9 +121,14 @@ TagEditorWidget::TagEditorWidget(QWidget *parent)
 #endif
     m_infoModel(nullptr)
     , m_infoTreeView(nullptr)
+    , m_fileInfo(make_unique<MediaFileInfo>())
     , m_nextFileAfterSaving(false)
     , m_makingResultsAvailable(false)
     , m_abortClicked(false)
+    , m_saveQueue(new SaveQueue(this))
+    , m_prefetchResult(ParsingSuccessful)
+    , m_prefetchedFullParse(false)
+    , m_adoptPrefetchedFile(false)
 {
     // setup UI
     m_ui->setupUi(this);
@@ -97,7 +138,7 @@ TagEditorWidget::TagEditorWidget(QWidget *parent)
     initInfoView();
 
     // setup file watcher
-    m_fileWatcher = new QFileSystemWatcher(this);
+    m_currentFileWatched = false;
     m_fileChangedOnDisk = false;
 
     // setup command link button icons
@@ -154,8 +195,13 @@ TagEditorWidget::TagEditorWidget(QWidget *parent)
     });
     connect(m_ui->tagSelectionComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated), m_ui->stackedWidget,
         &QStackedWidget::setCurrentIndex);
-    connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, &TagEditorWidget::fileChangedOnDisk);
-    m_fileInfo.setWritingApplication(APP_NAME " v" APP_VERSION);
+    auto &fileWatcher = FileWatcher::instance();
+    connect(&fileWatcher, &FileWatcher::fileChanged, this, &TagEditorWidget::fileChangedOnDisk);
+    connect(&fileWatcher, &FileWatcher::fileRemoved, this, &TagEditorWidget::fileChangedOnDisk);
+    connect(&fileWatcher, &FileWatcher::directoryChanged, this, &TagEditorWidget::directoryChangedOnDisk);
+    connect(m_saveQueue, &SaveQueue::progressChanged, this, &TagEditorWidget::showBackgroundSavingProgress);
+    connect(m_saveQueue, &SaveQueue::fileSaved, this, &TagEditorWidget::showBackgroundSavingResult);
+    m_fileInfo->setWritingApplication(APP_NAME " v" APP_VERSION);
 
     // apply settings
     applySettingsFromDialog();
@@ -170,6 +216,10 @@ TagEditorWidget::~TagEditorWidget()
         cout << Phrases::Warning << "Waiting for the ongoing file operation to finish ..." << Phrases::EndFlush;
         m_ongoingFileOperation.waitForFinished();
     }
+    m_prefetchOperation.waitForFinished();
+    if (!m_watchedDirectory.isEmpty()) {
+        FileWatcher::instance().unwatchDirectory(m_watchedDirectory);
+    }
 }
 
 /*!
@@ -179,7 +229,7 @@ TagEditorWidget::~TagEditorWidget()
 const QByteArray &TagEditorWidget::generateFileInfoHtml()
 {
     if (m_fileInfoHtml.isEmpty()) {
-        m_fileInfoHtml = HtmlInfo::generateInfo(m_fileInfo, m_diag, m_diagReparsing);
+        m_fileInfoHtml = HtmlInfo::generateInfo(*m_fileInfo, m_diag, m_diagReparsing);
     }
     return m_fileInfoHtml;
 }
@@ -271,7 +321,7 @@ bool TagEditorWidget::event(QEvent *event)
 void TagEditorWidget::updateDocumentTitleEdits()
 {
     // get container, segment count and present titles
-    const auto *const container = m_fileInfo.container();
+    const auto *const container = m_fileInfo->container();
     const auto segmentCount = [&] {
         constexpr auto segmentLimit = 10;
         const auto count = container ? container->segmentCount() : static_cast<size_t>(0);
@@ -409,14 +459,14 @@ void TagEditorWidget::updateTagEditsAndAttachmentEdits(bool updateUi, PreviousVa
     }
 
     // add/update AttachmentsEdit widget
-    if (m_fileInfo.areAttachmentsSupported()) {
+    if (m_fileInfo->areAttachmentsSupported()) {
         AttachmentsEdit *edit;
         // reuse existing edit (assigned in if-condition!) or ...
         if ((widgetIndex < m_ui->stackedWidget->count()) && (edit = qobject_cast<AttachmentsEdit *>(m_ui->stackedWidget->widget(widgetIndex)))) {
-            edit->setFileInfo(&m_fileInfo, true);
+            edit->setFileInfo(m_fileInfo.get(), true);
         } else {
             // ... create and add a new edit
-            edit = new AttachmentsEdit(&m_fileInfo, this);
+            edit = new AttachmentsEdit(m_fileInfo.get(), this);
             connect(m_ui->clearEntriesPushButton, &QPushButton::clicked, edit, &AttachmentsEdit::clear);
             connect(m_ui->restoreEntriesPushButton, &QPushButton::clicked, edit, &AttachmentsEdit::restore);
             //connect(edit, &AttachmentsEdit::returnPressed, this, &TagEditorWidget::handleReturnPressed);
@@ -440,7 +490,7 @@ void TagEditorWidget::updateTagEditsAndAttachmentEdits(bool updateUi, PreviousVa
  */
 void TagEditorWidget::updateTagSelectionComboBox()
 {
-    if (m_fileInfo.isOpen()) {
+    if (m_fileInfo->isOpen()) {
         // memorize the index of the previously selected edit
         int previouslySelectedEditIndex = m_ui->tagSelectionComboBox->currentIndex();
         // clear old entries and create new labels
@@ -475,13 +525,13 @@ void TagEditorWidget::updateTagSelectionComboBox()
  */
 void TagEditorWidget::updateFileStatusStatus()
 {
-    const bool opened = m_fileInfo.isOpen();
+    const bool opened = m_fileInfo->isOpen();
     const bool hasTag = opened && m_tags.size();
     // notification widgets
     m_ui->parsingNotificationWidget->setVisible(opened);
     m_ui->makingNotificationWidget->setVisible(opened && (m_makingResultsAvailable));
     // document title widget
-    const bool showDocumentTitle = opened && m_fileInfo.container() && m_fileInfo.container()->supportsTitle();
+    const bool showDocumentTitle = opened && m_fileInfo->container() && m_fileInfo->container()->supportsTitle();
     m_ui->docTitleLabel->setVisible(showDocumentTitle);
     m_ui->docTitleWidget->setVisible(showDocumentTitle);
     // buttons and actions to save, delete, close
@@ -521,12 +571,12 @@ void TagEditorWidget::updateTagManagementMenu()
     m_addTagMenu->clear();
     m_removeTagMenu->clear();
     m_changeTargetMenu->clear();
-    if (m_fileInfo.isOpen()) {
+    if (m_fileInfo->isOpen()) {
         // add "Add tag" actions
-        if (m_fileInfo.areTagsSupported() && m_fileInfo.container()) {
+        if (m_fileInfo->areTagsSupported() && m_fileInfo->container()) {
             // there is a container object which is able to create tags
             QString label;
-            switch (m_fileInfo.containerFormat()) {
+            switch (m_fileInfo->containerFormat()) {
             case ContainerFormat::Matroska:
             case ContainerFormat::Webm:
                 // tag format supports targets (Matroska tags are currently the only tag format supporting targets.)
@@ -535,7 +585,7 @@ void TagEditorWidget::updateTagManagementMenu()
                     std::bind(&TagEditorWidget::addTag, this, [this](MediaFileInfo &file) -> TagParser::Tag * {
                         if (file.container()) {
                             EnterTargetDialog targetDlg(this);
-                            targetDlg.setTarget(TagTarget(50), &this->m_fileInfo);
+                            targetDlg.setTarget(TagTarget(50), m_fileInfo.get());
                             if (targetDlg.exec() == QDialog::Accepted) {
                                 return file.container()->createTag(targetDlg.target());
                             }
@@ -546,8 +596,8 @@ void TagEditorWidget::updateTagManagementMenu()
 
             default:
                 // tag format does not support targets
-                if (!m_fileInfo.container()->tagCount()) {
-                    switch (m_fileInfo.containerFormat()) {
+                if (!m_fileInfo->container()->tagCount()) {
+                    switch (m_fileInfo->containerFormat()) {
                     case ContainerFormat::Mp4:
                         label = tr("MP4/iTunes tag");
                         break;
@@ -564,9 +614,9 @@ void TagEditorWidget::updateTagManagementMenu()
             }
         } else {
             // there is no container object which is able to create tags
-            switch (m_fileInfo.containerFormat()) {
+            switch (m_fileInfo->containerFormat()) {
             case ContainerFormat::Flac:
-                if (!m_fileInfo.vorbisComment()) {
+                if (!m_fileInfo->vorbisComment()) {
                     connect(m_addTagMenu->addAction(tr("Vorbis comment")), &QAction::triggered,
                         std::bind(&TagEditorWidget::addTag, this, [](MediaFileInfo &file) { return file.createVorbisComment(); }));
                 }
@@ -574,11 +624,11 @@ void TagEditorWidget::updateTagManagementMenu()
 
             default:
                 // creation of ID3 tags is always possible
-                if (!m_fileInfo.hasId3v1Tag()) {
+                if (!m_fileInfo->hasId3v1Tag()) {
                     connect(m_addTagMenu->addAction(tr("ID3v1 tag")), &QAction::triggered,
                         std::bind(&TagEditorWidget::addTag, this, [](MediaFileInfo &file) { return file.createId3v1Tag(); }));
                 }
-                if (!m_fileInfo.hasId3v2Tag()) {
+                if (!m_fileInfo->hasId3v2Tag()) {
                     connect(m_addTagMenu->addAction(tr("ID3v2 tag")), &QAction::triggered,
                         std::bind(&TagEditorWidget::addTag, this, [](MediaFileInfo &file) { return file.createId3v2Tag(); }));
                 }
@@ -686,7 +736,7 @@ void TagEditorWidget::initInfoView()
         }
         if (!m_infoModel) {
             m_infoModel = new FileInfoModel(this);
-            m_infoModel->setFileInfo(m_fileInfo, m_diag, m_makingResultsAvailable ? &m_diagReparsing : nullptr);
+            m_infoModel->setFileInfo(*m_fileInfo, m_diag, m_makingResultsAvailable ? &m_diagReparsing : nullptr);
             m_infoTreeView->setModel(m_infoModel);
             m_infoTreeView->setHeaderHidden(true);
             m_infoTreeView->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
@@ -707,7 +757,7 @@ void TagEditorWidget::updateInfoView()
     // update webview if present
 #ifndef TAGEDITOR_NO_WEBVIEW
     if (m_infoWebView) {
-        if (m_fileInfo.isOpen()) {
+        if (m_fileInfo->isOpen()) {
             m_infoWebView->setContent(generateFileInfoHtml(), QStringLiteral("application/xhtml+xml"));
         } else {
             m_infoWebView->setUrl(QStringLiteral("about:blank"));
@@ -717,7 +767,7 @@ void TagEditorWidget::updateInfoView()
 
     // update info model if present
     if (m_infoModel) {
-        m_infoModel->setFileInfo(m_fileInfo, m_diag, m_makingResultsAvailable ? &m_diagReparsing : nullptr); // resets the model
+        m_infoModel->setFileInfo(*m_fileInfo, m_diag, m_makingResultsAvailable ? &m_diagReparsing : nullptr); // resets the model
     }
 }
 
@@ -789,7 +839,7 @@ void TagEditorWidget::foreachTagEdit(const std::function<void(TagEdit *)> &funct
  */
 TagEdit *TagEditorWidget::activeTagEdit()
 {
-    return m_fileInfo.isOpen() ? qobject_cast<TagEdit *>(m_ui->stackedWidget->currentWidget()) : nullptr;
+    return m_fileInfo->isOpen() ? qobject_cast<TagEdit *>(m_ui->stackedWidget->currentWidget()) : nullptr;
 }
 
 /*!
@@ -811,17 +861,27 @@ bool TagEditorWidget::startParsing(const QString &path, bool forceRefresh)
         emit statusMessage(tr("Unable to load the selected file \"%1\" because the current process hasn't finished yet.").arg(path));
         return false;
     }
+    // defer loading files which are still being saved in the background
+    m_pathAfterSaving.clear();
+    if (m_saveQueue->contains(path)) {
+        m_pathAfterSaving = path;
+        emit statusMessage(tr("The file \"%1\" will be loaded as soon as it has been saved.").arg(path));
+        return false;
+    }
 
     // clear previous results and status
     m_tags.clear();
-    m_fileInfo.clearParsingResults();
+    if (m_infoModel) {
+        m_infoModel->discardPendingRows();
+    }
+    m_fileInfo->clearParsingResults();
     if (!sameFile) {
         // close last file if possibly open
-        m_fileInfo.close();
+        m_fileInfo->close();
         // set path of file info
         m_currentPath = path;
-        m_fileInfo.setSaveFilePath(string());
-        m_fileInfo.setPath(toNativeFileName(path).data());
+        m_fileInfo->setSaveFilePath(string());
+        m_fileInfo->setPath(toNativeFileName(path).data());
         // update file name and directory
         const QFileInfo fileInfo(path);
         m_lastDir = m_currentDir;
@@ -836,49 +896,122 @@ bool TagEditorWidget::startParsing(const QString &path, bool forceRefresh)
     m_diagReparsing.clear();
     // show filename
     m_ui->fileNameLabel->setText(m_fileName);
-    // define function to parse the file
-    const auto startThread = [this, &diag] {
-        char result;
-        try { // credits for this nesting go to GCC regression 66145
-            try {
-                // try to open with write access
-                try {
-                    m_fileInfo.reopen(false);
-                } catch (const std::ios_base::failure &) {
-                    // try to open read-only if opening with write access failed
-                    m_fileInfo.reopen(true);
-                }
-                m_fileInfo.setForceFullParse(Settings::values().editor.forceFullParse);
-                m_fileInfo.parseEverything(diag);
-                result = ParsingSuccessful;
-            } catch (const Failure &) {
-                // the file has been opened; parsing notifications will be shown in the info box
-                result = FatalParsingError;
-            } catch (const std::ios_base::failure &) {
-                // the file could not be opened because an IO error occured
-                m_fileInfo.close(); // ensure file is closed
-                result = IoError;
-            }
-        } catch (const exception &e) {
-            diag.emplace_back(TagParser::DiagLevel::Critical, argsToString("Something completely unexpected happened: ", +e.what()), "parsing");
-            result = FatalParsingError;
-        } catch (...) {
-            diag.emplace_back(TagParser::DiagLevel::Critical, "Something completely unexpected happened", "parsing");
-            result = FatalParsingError;
-        }
-        QMetaObject::invokeMethod(this, "showFile", Qt::QueuedConnection, Q_ARG(char, result));
-    };
-    // perform the operation concurrently
-    m_ongoingFileOperation = QtConcurrent::run(startThread);
+    // use the file which has been parsed in advance (or is still being parsed) if possible
+    const auto prefetchOngoing = m_prefetchResult == ParsingOngoing;
+    const auto usePrefetchedFile = !sameFile && m_prefetchedPath == path && (prefetchOngoing || isPrefetchedFileUpToDate());
+    if (usePrefetchedFile) {
+        m_adoptPrefetchedFile = true;
+        m_ongoingFileOperation = m_prefetchOperation;
+    } else {
+        // parse the file concurrently
+        const auto forceFullParse = Settings::values().editor.forceFullParse;
+        m_ongoingFileOperation = QtConcurrent::run([this, &diag, forceFullParse] {
+            const char result = parseFile(*m_fileInfo, diag, forceFullParse);
+            QMetaObject::invokeMethod(this, "showFile", Qt::QueuedConnection, Q_ARG(char, result));
+        });
+    }
     // inform user
     static const auto statusMsg(tr("The file is beeing parsed ..."));
     m_ui->parsingNotificationWidget->setNotificationType(NotificationType::Progress);
     m_ui->parsingNotificationWidget->setText(statusMsg);
     m_ui->parsingNotificationWidget->setVisible(true); // ensure widget is visible!
     emit statusMessage(statusMsg);
+    // show the prefetched file immediately if it has already been parsed; otherwise handlePrefetchFinished() will do it
+    if (usePrefetchedFile && !prefetchOngoing) {
+        adoptPrefetchedFile();
+    }
     return true;
 }
 
+/*!
+ * \brief Parses the specified file in advance using another thread.
+ *
+ * Invoking startParsing() with the same \a path later shows the file without having to wait for parsing it (again). This
+ * is used to parse the next file within the file browser while the user is still editing the current file.
+ *
+ * \remarks
+ * - Only one file is parsed in advance at a time. If another file is still being parsed in advance, the specified
+ *   file is parsed after it has been finished.
+ * - The prefetched results are discarded when startParsing() is invoked with the same path but the file has been
+ *   modified in the meantime.
+ */
+void TagEditorWidget::prefetchFile(const QString &path)
+{
+    if (!Settings::values().fileBrowser.prefetchNextFile || path.isEmpty() || path == m_currentPath || m_saveQueue->contains(path)) {
+        return;
+    }
+    const auto prefetchOngoing = m_prefetchResult == ParsingOngoing;
+    if (path == m_prefetchedPath && (prefetchOngoing || isPrefetchedFileUpToDate())) {
+        return;
+    }
+    if (prefetchOngoing) {
+        m_pendingPrefetchPath = path;
+        return;
+    }
+    m_pendingPrefetchPath.clear();
+
+    // reuse the file info which has previously been used for prefetching (or which has been swapped out by adoptPrefetchedFile())
+    if (!m_prefetchedFileInfo) {
+        m_prefetchedFileInfo = make_unique<MediaFileInfo>();
+        m_prefetchedFileInfo->setWritingApplication(APP_NAME " v" APP_VERSION);
+    }
+    m_prefetchedFileInfo->close();
+    m_prefetchedFileInfo->clearParsingResults();
+    m_prefetchedFileInfo->setSaveFilePath(string());
+    m_prefetchedFileInfo->setPath(toNativeFileName(path).data());
+    m_prefetchedDiag.clear();
+    m_prefetchedPath = path;
+    m_prefetchedLastModified = QFileInfo(path).lastModified();
+    m_prefetchedFullParse = Settings::values().editor.forceFullParse;
+    m_prefetchResult = ParsingOngoing;
+    m_prefetchOperation = QtConcurrent::run([this, forceFullParse = m_prefetchedFullParse] {
+        const char result = parseFile(*m_prefetchedFileInfo, m_prefetchedDiag, forceFullParse);
+        QMetaObject::invokeMethod(this, "handlePrefetchFinished", Qt::QueuedConnection, Q_ARG(char, result));
+    });
+}
+
+/*!
+ * \brief Handles the results of parsing a file in advance.
+ *
+ * This private slot is invoked from the thread which performed the parsing operation using Qt::QueuedConnection.
+ */
+void TagEditorWidget::handlePrefetchFinished(char result)
+{
+    m_prefetchResult = result;
+    if (m_adoptPrefetchedFile) {
+        adoptPrefetchedFile();
+    }
+    if (!m_pendingPrefetchPath.isEmpty()) {
+        const auto path = m_pendingPrefetchPath;
+        m_pendingPrefetchPath.clear();
+        prefetchFile(path);
+    }
+}
+
+/*!
+ * \brief Returns whether the results of parsing a file in advance can still be used.
+ */
+bool TagEditorWidget::isPrefetchedFileUpToDate() const
+{
+    return m_prefetchedFileInfo && m_prefetchedFullParse == Settings::values().editor.forceFullParse
+        && QFileInfo(m_prefetchedPath).lastModified() == m_prefetchedLastModified;
+}
+
+/*!
+ * \brief Makes the file which has been parsed in advance the current file and shows it.
+ * \remarks The previous file info is kept for parsing the next file in advance.
+ */
+void TagEditorWidget::adoptPrefetchedFile()
+{
+    m_adoptPrefetchedFile = false;
+    m_fileInfo.swap(m_prefetchedFileInfo);
+    m_prefetchedFileInfo->close();
+    m_diag.swap(m_prefetchedDiag);
+    m_prefetchedDiag.clear();
+    m_prefetchedPath.clear();
+    showFile(m_prefetchResult);
+}
+
 /*!
  * \brief Reparses the current file.
  */
@@ -888,7 +1021,7 @@ bool TagEditorWidget::reparseFile()
         emit statusMessage(tr("Unable to reload the file because the current process hasn't finished yet."));
         return false;
     }
-    if (!m_fileInfo.isOpen() || m_currentPath.isEmpty()) {
+    if (!m_fileInfo->isOpen() || m_currentPath.isEmpty()) {
         QMessageBox::warning(this, windowTitle(), tr("Currently is not file opened."));
         return false;
     }
@@ -918,7 +1051,7 @@ void TagEditorWidget::showFile(char result)
     } else {
         // load existing tags
         m_tags.clear();
-        m_fileInfo.tags(m_tags);
+        m_fileInfo->tags(m_tags);
         // show notification if no existing tag(s) could be found
         if (!m_tags.size()) {
             m_ui->parsingNotificationWidget->appendLine(tr("There is no (supported) tag assigned."));
@@ -932,22 +1065,22 @@ void TagEditorWidget::showFile(char result)
             for (const ChecklistItem &targetItem : Settings::values().editor.defaultTargets.items()) {
                 if (targetItem.isChecked()) {
                     settings.creationSettings.requiredTargets.emplace_back(
-                        containerTargetLevelValue(m_fileInfo.containerFormat(), static_cast<TagTargetLevel>(targetItem.id().toInt())));
+                        containerTargetLevelValue(m_fileInfo->containerFormat(), static_cast<TagTargetLevel>(targetItem.id().toInt())));
                 }
             }
             // TODO: allow initialization of new ID3 tag with values from already present ID3 tag
             // TODO: allow not to transfer values from removed ID3 tag to remaining ID3 tags
             // TODO: still show the version as on disk in the info view
             settings.creationSettings.flags -= TagCreationFlags::KeepExistingId3v2Version;
-            if (!m_fileInfo.createAppropriateTags(settings.creationSettings)) {
+            if (!m_fileInfo->createAppropriateTags(settings.creationSettings)) {
                 if (confirmCreationOfId3TagForUnsupportedFile()) {
                     settings.creationSettings.flags += TagCreationFlags::KeepExistingId3v2Version;
-                    m_fileInfo.createAppropriateTags(settings.creationSettings);
+                    m_fileInfo->createAppropriateTags(settings.creationSettings);
                 }
             }
             // tags might have been adjusted -> reload tags
             m_tags.clear();
-            m_fileInfo.tags(m_tags);
+            m_fileInfo->tags(m_tags);
         }
 
         // show parsing status/result using parsing notification widget
@@ -969,21 +1102,21 @@ void TagEditorWidget::showFile(char result)
             m_ui->parsingNotificationWidget->setNotificationType(NotificationType::Critical);
             m_ui->parsingNotificationWidget->setText(tr("File couldn't be parsed correctly."));
         }
-        bool multipleSegmentsNotTested = m_fileInfo.containerFormat() == ContainerFormat::Matroska && m_fileInfo.container()->segmentCount() > 1;
+        bool multipleSegmentsNotTested = m_fileInfo->containerFormat() == ContainerFormat::Matroska && m_fileInfo->container()->segmentCount() > 1;
         if (diagLevel >= TagParser::DiagLevel::Critical) {
             m_ui->parsingNotificationWidget->setNotificationType(NotificationType::Critical);
             m_ui->parsingNotificationWidget->appendLine(tr("Errors occured."));
-        } else if (diagLevel == TagParser::DiagLevel::Warning || m_fileInfo.isReadOnly() || !m_fileInfo.areTagsSupported()
+        } else if (diagLevel == TagParser::DiagLevel::Warning || m_fileInfo->isReadOnly() || !m_fileInfo->areTagsSupported()
             || multipleSegmentsNotTested) {
             m_ui->parsingNotificationWidget->setNotificationType(NotificationType::Warning);
             if (diagLevel == TagParser::DiagLevel::Warning) {
                 m_ui->parsingNotificationWidget->appendLine(tr("There are warnings."));
             }
         }
-        if (m_fileInfo.isReadOnly()) {
+        if (m_fileInfo->isReadOnly()) {
             m_ui->parsingNotificationWidget->appendLine(tr("No write access; the file has been opened in read-only mode."));
         }
-        if (!m_fileInfo.areTagsSupported()) {
+        if (!m_fileInfo->areTagsSupported()) {
             m_ui->parsingNotificationWidget->appendLine(tr("File format is not supported (an ID3 tag can be added anyways)."));
         }
         if (multipleSegmentsNotTested) {
@@ -992,7 +1125,17 @@ void TagEditorWidget::showFile(char result)
         }
 
         // update relevant (UI) components
-        m_fileWatcher->addPath(m_currentPath);
+        const QFileInfo currentFileInfo(m_currentPath);
+        const auto currentDirectory = currentFileInfo.absolutePath();
+        if (m_watchedDirectory != currentDirectory) {
+            auto &fileWatcher = FileWatcher::instance();
+            if (!m_watchedDirectory.isEmpty()) {
+                fileWatcher.unwatchDirectory(m_watchedDirectory);
+            }
+            fileWatcher.watchDirectory(m_watchedDirectory = currentDirectory);
+        }
+        m_currentLastModified = currentFileInfo.lastModified();
+        m_currentFileWatched = true;
         m_fileChangedOnDisk = false;
         updateInfoView();
         updateDocumentTitleEdits();
@@ -1032,7 +1175,7 @@ bool TagEditorWidget::applyEntriesAndSaveChangings()
     m_ui->makingNotificationWidget->setNotificationSubject(NotificationSubject::Saving);
     m_ui->makingNotificationWidget->setHidden(false);
 
-    if (!m_fileInfo.isOpen()) {
+    if (!m_fileInfo->isOpen()) {
         m_ui->makingNotificationWidget->setText(tr("No file has been opened, so tags can not be saved."));
         return false;
     }
@@ -1040,7 +1183,7 @@ bool TagEditorWidget::applyEntriesAndSaveChangings()
     m_makingResultsAvailable = true;
 
     // apply titles
-    AbstractContainer *const container = m_fileInfo.container();
+    AbstractContainer *const container = m_fileInfo->container();
     if (container && container->supportsTitle()) {
         QLayout *const docTitleLayout = m_ui->docTitleWidget->layout();
         for (std::size_t i = 0, count = min<std::size_t>(static_cast<std::size_t>(docTitleLayout->count()), container->segmentCount()); i < count;
@@ -1074,11 +1217,11 @@ bool TagEditorWidget::deleteAllTagsAndSave()
     m_ui->makingNotificationWidget->setNotificationType(NotificationType::Information);
     m_ui->makingNotificationWidget->setHidden(false);
 
-    if (!m_fileInfo.isOpen()) {
+    if (!m_fileInfo->isOpen()) {
         m_ui->makingNotificationWidget->setText(tr("No file has been opened, so no tags can be deleted."));
         return false;
     }
-    if (!m_fileInfo.hasAnyTag()) {
+    if (!m_fileInfo->hasAnyTag()) {
         m_ui->makingNotificationWidget->setText(tr("The selected file has no tag (at least no supported), so there is nothing to delete."));
         return false;
     }
@@ -1111,7 +1254,7 @@ bool TagEditorWidget::deleteAllTagsAndSave()
     m_makingResultsAvailable = true;
 
     foreachTagEdit([](TagEdit *edit) { edit->clear(); });
-    m_fileInfo.removeAllTags();
+    m_fileInfo->removeAllTags();
     m_ui->makingNotificationWidget->setNotificationSubject(NotificationSubject::None);
     m_ui->makingNotificationWidget->setNotificationType(NotificationType::Progress);
     static const QString statusMsg(tr("Deleting all tags ..."));
@@ -1140,24 +1283,33 @@ bool TagEditorWidget::startSaving()
     // tags might get invalidated
     m_tags.clear();
     foreachTagEdit([](TagEdit *edit) { edit->setTag(nullptr, false); });
+    // the info model must not access the file while it is modified
+    if (m_infoModel) {
+        m_infoModel->discardPendingRows();
+    }
+    // ignore changes on disk caused by saving the file
+    m_currentFileWatched = false;
+    // use current configuration
+    const auto &settings = Settings::values();
+    const auto &fileLayoutSettings = settings.tagPocessing.fileLayout;
+    m_fileInfo->setForceRewrite(fileLayoutSettings.forceRewrite);
+    m_fileInfo->setTagPosition(fileLayoutSettings.preferredTagPosition);
+    m_fileInfo->setForceTagPosition(fileLayoutSettings.forceTagPosition);
+    m_fileInfo->setIndexPosition(fileLayoutSettings.preferredIndexPosition);
+    m_fileInfo->setForceIndexPosition(fileLayoutSettings.forceIndexPosition);
+    m_fileInfo->setMinPadding(fileLayoutSettings.minPadding);
+    m_fileInfo->setMaxPadding(fileLayoutSettings.maxPadding);
+    m_fileInfo->setPreferredPadding(fileLayoutSettings.preferredPadding);
+    m_fileInfo->setBackupDirectory(settings.editor.backupDirectory);
+    // let the save queue apply the changes when the next file should be shown anyways
+    if (m_nextFileAfterSaving && settings.editor.saveInBackground) {
+        saveInBackgroundAndShowNextFile();
+        return true;
+    }
     // show abort button
     m_ui->abortButton->setHidden(false);
     m_ui->abortButton->setEnabled(true);
     m_abortClicked = false;
-    // remove current path from file watcher
-    m_fileWatcher->removePath(m_currentPath);
-    // use current configuration
-    const auto &settings = Settings::values();
-    const auto &fileLayoutSettings = settings.tagPocessing.fileLayout;
-    m_fileInfo.setForceRewrite(fileLayoutSettings.forceRewrite);
-    m_fileInfo.setTagPosition(fileLayoutSettings.preferredTagPosition);
-    m_fileInfo.setForceTagPosition(fileLayoutSettings.forceTagPosition);
-    m_fileInfo.setIndexPosition(fileLayoutSettings.preferredIndexPosition);
-    m_fileInfo.setForceIndexPosition(fileLayoutSettings.forceIndexPosition);
-    m_fileInfo.setMinPadding(fileLayoutSettings.minPadding);
-    m_fileInfo.setMaxPadding(fileLayoutSettings.maxPadding);
-    m_fileInfo.setPreferredPadding(fileLayoutSettings.preferredPadding);
-    m_fileInfo.setBackupDirectory(settings.editor.backupDirectory);
     const auto startThread = [this] {
         // define functions to show the saving progress and to actually applying the changes
         auto showPercentage([this](AbortableProgressFeedback &progress) {
@@ -1180,7 +1332,7 @@ bool TagEditorWidget::startSaving()
         bool processingError = false, ioError = false, canceled = false;
         try {
             try {
-                m_fileInfo.applyChanges(m_diag, progress);
+                m_fileInfo->applyChanges(m_diag, progress);
             } catch (const OperationAbortedException &) {
                 canceled = true;
             } catch (const Failure &) {
@@ -1268,7 +1420,7 @@ void TagEditorWidget::showSavingResult(bool processingError, bool ioError, bool
             emit nextFileSelected();
         } else {
             // the current path might have changed through "save file path" mechanism
-            startParsing(m_currentPath = fromNativeFileName(m_fileInfo.path()), true);
+            startParsing(m_currentPath = fromNativeFileName(m_fileInfo->path()), true);
         }
         m_nextFileAfterSaving = false;
     } else {
@@ -1284,12 +1436,92 @@ void TagEditorWidget::showSavingResult(bool processingError, bool ioError, bool
         m_ui->makingNotificationWidget->setNotificationType(NotificationType::Critical);
 
         // -> reset "save as path" in any case after fatal error
-        m_fileInfo.setSaveFilePath(string());
+        m_fileInfo->setSaveFilePath(string());
 
         startParsing(m_currentPath, true);
     }
 }
 
+/*!
+ * \brief Hands the current file over to the save queue and shows the next file immediately.
+ * \remarks The file is loaded again after it has been saved if no next file has been loaded in the meantime.
+ */
+void TagEditorWidget::saveInBackgroundAndShowNextFile()
+{
+    m_nextFileAfterSaving = false;
+    m_makingResultsAvailable = false;
+    // detach all editors from the file before handing it over to the save queue; they must not access its tags and
+    // attachments while it is saved in the background
+    m_tags.clear();
+    for (int i = 0, count = m_ui->stackedWidget->count(); i < count; ++i) {
+        if (auto *const tagEdit = qobject_cast<TagEdit *>(m_ui->stackedWidget->widget(i))) {
+            tagEdit->setTag(nullptr, true);
+        } else if (auto *const attachmentsEdit = qobject_cast<AttachmentsEdit *>(m_ui->stackedWidget->widget(i))) {
+            attachmentsEdit->setFileInfo(nullptr, true);
+        }
+    }
+    if (m_infoModel) {
+        m_infoModel->discardPendingRows();
+    }
+    m_saveQueue->enqueue(m_currentPath, std::move(m_fileInfo), std::move(m_diag));
+    m_fileInfo = make_unique<MediaFileInfo>();
+    m_fileInfo->setWritingApplication(APP_NAME " v" APP_VERSION);
+    m_diag.clear();
+    m_diagReparsing.clear();
+    m_pathAfterSaving = m_currentPath;
+    m_currentPath.clear();
+    updateInfoView();
+    updateFileStatusStatus();
+    emit nextFileSelected();
+}
+
+/*!
+ * \brief Shows the progress of saving a file in the background.
+ *
+ * This private slot is invoked from the thread which performs the saving operation using Qt::QueuedConnection.
+ */
+void TagEditorWidget::showBackgroundSavingProgress(const QString &path, const QString &step, int percentage)
+{
+    const auto queued = m_saveQueue->size() - 1;
+    auto statusMsg = tr("Saving \"%1\" in the background: %2 (%3 %)").arg(QFileInfo(path).fileName(), step).arg(percentage);
+    if (queued) {
+        statusMsg.append(tr(" - %1 more file(s) queued", nullptr, trQuandity(queued)).arg(queued));
+    }
+    emit statusMessage(statusMsg);
+}
+
+/*!
+ * \brief Shows the result of saving a file in the background and loads the file again if it has been deferred.
+ * \remarks Failures are collected and shown within a single message box once the queue is idle so aborting many
+ *          queued files (see SaveQueue::abortAll()) doesn't open a message box for each of them.
+ */
+void TagEditorWidget::showBackgroundSavingResult(const QString &path, const QString &message, bool failed)
+{
+    emit statusMessage(message);
+    if (failed) {
+        m_backgroundSavingFailures << message;
+    }
+    if (path == m_pathAfterSaving && !m_saveQueue->contains(path)) {
+        startParsing(path, true);
+    }
+    if (m_backgroundSavingFailures.isEmpty() || m_saveQueue->isBusy()) {
+        return;
+    }
+    // take the failures before showing the message box because further results might be reported meanwhile
+    const auto failures = std::move(m_backgroundSavingFailures);
+    m_backgroundSavingFailures.clear();
+    if (failures.size() == 1) {
+        QMessageBox::critical(this, QCoreApplication::applicationName(), failures.front());
+        return;
+    }
+    QMessageBox msgBox(this);
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.setWindowTitle(QCoreApplication::applicationName());
+    msgBox.setText(tr("%1 file(s) could not be saved in the background.", nullptr, trQuandity(failures.size())).arg(failures.size()));
+    msgBox.setDetailedText(failures.join(QChar('\n')));
+    msgBox.exec();
+}
+
 /*!
  * \brief Asks the user whether an ID3 tag should be add to a not supported container format and returns the result.
  */
@@ -1306,11 +1538,25 @@ bool TagEditorWidget::confirmCreationOfId3TagForUnsupportedFile()
 }
 
 /*!
- * \brief This slot is connected to the fileChanged() signal of the file info watcher.
+ * \brief This slot is connected to the fileChanged() and fileRemoved() signals of the file watcher.
+ *
+ * Discards the prefetched file if it has been changed and notifies the user if the currently opened file has
+ * been changed by another application.
  */
 void TagEditorWidget::fileChangedOnDisk(const QString &path)
 {
-    if (!m_fileChangedOnDisk && m_fileInfo.isOpen() && path == m_currentPath) {
+    if (path == m_prefetchedPath && m_prefetchResult != ParsingOngoing) {
+        m_prefetchedPath.clear();
+    }
+    if (!m_currentFileWatched || path != m_currentPath) {
+        return;
+    }
+    // ignore notifications caused by saving the file which arrive after the file has been parsed again
+    const QFileInfo currentFileInfo(path);
+    if (currentFileInfo.exists() && currentFileInfo.lastModified() == m_currentLastModified) {
+        return;
+    }
+    if (!m_fileChangedOnDisk && m_fileInfo->isOpen()) {
         auto &notifyWidget = *m_ui->parsingNotificationWidget;
         notifyWidget.appendLine(tr("The currently opened file changed on the disk."));
         notifyWidget.setNotificationType(
@@ -1319,6 +1565,21 @@ void TagEditorWidget::fileChangedOnDisk(const QString &path)
     }
 }
 
+/*!
+ * \brief This slot is connected to the directoryChanged() signal of the file watcher.
+ * \remarks The file watcher does not know which files have been changed in this case so the relevant files are checked.
+ */
+void TagEditorWidget::directoryChangedOnDisk(const QString &path)
+{
+    if (path != m_watchedDirectory) {
+        return;
+    }
+    if (!m_prefetchedPath.isEmpty() && m_prefetchResult != ParsingOngoing && !isPrefetchedFileUpToDate()) {
+        m_prefetchedPath.clear();
+    }
+    fileChangedOnDisk(m_currentPath);
+}
+
 /*!
  * \brief Closes the currently opened file and disables all related widgets.
  */
@@ -1330,9 +1591,13 @@ void TagEditorWidget::closeFile()
     }
 
     // close file
-    m_fileInfo.close();
-    // remove current path from file watcher
-    m_fileWatcher->removePath(m_currentPath);
+    m_fileInfo->close();
+    // stop watching the directory of the file
+    m_currentFileWatched = false;
+    if (!m_watchedDirectory.isEmpty()) {
+        FileWatcher::instance().unwatchDirectory(m_watchedDirectory);
+        m_watchedDirectory.clear();
+    }
     // update ui
     emit statusMessage("The file has been closed.");
     updateFileStatusStatus();
@@ -1413,7 +1678,7 @@ void TagEditorWidget::openFileInfoInBrowser()
  */
 void TagEditorWidget::handleReturnPressed()
 {
-    if (Settings::values().editor.saveAndShowNextOnEnter && m_fileInfo.isOpen()) {
+    if (Settings::values().editor.saveAndShowNextOnEnter && m_fileInfo->isOpen()) {
         saveAndShowNextFile();
     }
 }
@@ -1473,12 +1738,12 @@ void TagEditorWidget::addTag(const function<TagParser::Tag *(TagParser::MediaFil
         emit statusMessage("Unable to add a tag because the current process hasn't been finished yet.");
         return;
     }
-    if (!m_fileInfo.isOpen()) {
+    if (!m_fileInfo->isOpen()) {
         emit statusMessage("Unable to add a tag because no file is opened.");
         return;
     }
 
-    Tag *const tag = createTag(m_fileInfo);
+    Tag *const tag = createTag(*m_fileInfo);
     if (!tag) {
         QMessageBox::warning(this, windowTitle(), tr("The tag can not be created."));
         return;
@@ -1510,13 +1775,13 @@ void TagEditorWidget::removeTag(Tag *tag)
         emit statusMessage(tr("Unable to remove the tag because the current process hasn't been finished yet."));
         return;
     }
-    if (!m_fileInfo.isOpen()) {
+    if (!m_fileInfo->isOpen()) {
         emit statusMessage(tr("Unable to remove the tag because no file is opened."));
         return;
     }
 
     // remove tag itself
-    m_fileInfo.removeTag(tag);
+    m_fileInfo->removeTag(tag);
     m_tags.erase(remove(m_tags.begin(), m_tags.end(), tag), m_tags.end());
 
     // remove tag from all TagEdit widgets
@@ -1574,7 +1839,7 @@ void TagEditorWidget::changeTarget(Tag *tag)
         emit statusMessage(tr("Unable to change the target because the current process hasn't been finished yet."));
         return;
     }
-    if (!m_fileInfo.isOpen()) {
+    if (!m_fileInfo->isOpen()) {
         emit statusMessage(tr("Unable to change the target because no file is opened."));
         return;
     }
@@ -1584,7 +1849,7 @@ void TagEditorWidget::changeTarget(Tag *tag)
     }
 
     EnterTargetDialog targetDlg(this);
-    targetDlg.setTarget(tag->target(), &m_fileInfo);
+    targetDlg.setTarget(tag->target(), m_fileInfo.get());
     if (targetDlg.exec() != QDialog::Accepted) {
         return;
     }
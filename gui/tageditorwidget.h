@@ -8,12 +8,13 @@
 #include <tagparser/mediafileinfo.h>
 
 #include <QByteArray>
+#include <QDateTime>
 #include <QFuture>
+#include <QStringList>
 #include <QWidget>
 
 #include <functional>
 
-QT_FORWARD_DECLARE_CLASS(QFileSystemWatcher)
 QT_FORWARD_DECLARE_CLASS(QMenu)
 QT_FORWARD_DECLARE_CLASS(QTreeView)
 QT_FORWARD_DECLARE_CLASS(QFile)
@@ -33,6 +34,7 @@ class TagEditorWidget;
 
 class TagEdit;
 class FileInfoModel;
+class SaveQueue;
 
 class TagEditorWidget : public QWidget {
     Q_OBJECT
@@ -53,6 +55,7 @@ public:
     const QString &currentPath() const;
     const QString &currentDir() const;
     TagParser::MediaFileInfo &fileInfo();
+    SaveQueue &saveQueue();
     const TagParser::Diagnostics &diagnostics() const;
     bool isTagEditShown() const;
     const QByteArray &fileInfoHtml() const;
@@ -67,6 +70,7 @@ public:
 public Q_SLOTS:
     // operations with the currently opened file: load, save, delete, close
     bool startParsing(const QString &path, bool forceRefresh = false);
+    void prefetchFile(const QString &path);
     bool startSaving();
     void saveAndShowNextFile();
     bool reparseFile();
@@ -101,7 +105,9 @@ protected:
 private Q_SLOTS:
     // editor
     void fileChangedOnDisk(const QString &path);
+    void directoryChangedOnDisk(const QString &path);
     void showFile(char result);
+    void handlePrefetchFinished(char result);
     void handleReturnPressed();
     void handleKeepPreviousValuesActionTriggered(QAction *action);
     void addTag(const std::function<TagParser::Tag *(TagParser::MediaFileInfo &)> &createTag);
@@ -110,6 +116,8 @@ private Q_SLOTS:
 
     // saving
     void showSavingResult(bool processingError, bool ioError, bool canceled);
+    void showBackgroundSavingProgress(const QString &path, const QString &step, int percentage);
+    void showBackgroundSavingResult(const QString &path, const QString &message, bool failed);
 
     // info (web) view
     void initInfoView();
@@ -130,6 +138,9 @@ private:
     void updateKeepPreviousValuesButton();
     void insertTitleFromFilename();
     bool confirmCreationOfId3TagForUnsupportedFile();
+    void saveInBackgroundAndShowNextFile();
+    bool isPrefetchedFileUpToDate() const;
+    void adoptPrefetchedFile();
 
     // UI
     std::unique_ptr<Ui::TagEditorWidget> m_ui;
@@ -146,9 +157,11 @@ private:
     std::unique_ptr<QTemporaryFile> m_temporaryInfoFile;
     // tag, file, directory management
     QString m_currentPath;
-    QFileSystemWatcher *m_fileWatcher;
+    QString m_watchedDirectory;
+    QDateTime m_currentLastModified;
+    bool m_currentFileWatched;
     bool m_fileChangedOnDisk;
-    TagParser::MediaFileInfo m_fileInfo;
+    std::unique_ptr<TagParser::MediaFileInfo> m_fileInfo;
     std::vector<TagParser::Tag *> m_tags;
     QByteArray m_fileInfoHtml;
     QString m_fileName;
@@ -162,6 +175,20 @@ private:
     bool m_nextFileAfterSaving;
     bool m_makingResultsAvailable;
     bool m_abortClicked;
+    // saving in the background
+    SaveQueue *m_saveQueue;
+    QString m_pathAfterSaving;
+    QStringList m_backgroundSavingFailures;
+    // prefetching of the next file
+    std::unique_ptr<TagParser::MediaFileInfo> m_prefetchedFileInfo;
+    TagParser::Diagnostics m_prefetchedDiag;
+    QString m_prefetchedPath;
+    QString m_pendingPrefetchPath;
+    QDateTime m_prefetchedLastModified;
+    QFuture<void> m_prefetchOperation;
+    char m_prefetchResult;
+    bool m_prefetchedFullParse;
+    bool m_adoptPrefetchedFile;
 };
 
 /*!
@@ -169,7 +196,7 @@ private:
  */
 inline bool TagEditorWidget::isFileOperationOngoing() const
 {
-    return m_ongoingFileOperation.isRunning();
+    return m_ongoingFileOperation.isRunning() || m_adoptPrefetchedFile;
 }
 
 /*!
@@ -194,7 +221,15 @@ inline const QString &TagEditorWidget::currentDir() const
  */
 inline TagParser::MediaFileInfo &TagEditorWidget::fileInfo()
 {
-    return m_fileInfo;
+    return *m_fileInfo;
+}
+
+/*!
+ * \brief Returns the queue used to save files in the background.
+ */
+inline SaveQueue &TagEditorWidget::saveQueue()
+{
+    return *m_saveQueue;
 }
 
 /*!
@@ -0,0 +1,399 @@
+#include "./tagstatusfilesystemmodel.h"
+#include "./fileinfomodel.h"
+#include "./filewatcher.h"
+
+#include "../misc/utility.h"
+
+#include <tagparser/abstractattachment.h>
+#include <tagparser/exceptions.h>
+#include <tagparser/mediafileinfo.h>
+#include <tagparser/tag.h>
+
+#include <qtutilities/misc/conversion.h>
+
+#include <c++utilities/conversion/conversionexception.h>
+
+#include <QThread>
+#include <QtConcurrent>
+
+#ifdef PLATFORM_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace CppUtilities;
+using namespace QtUtilities;
+using namespace TagParser;
+
+namespace QtGui {
+
+/*!
+ * \brief Lowers the CPU and I/O priority of the calling thread so parsing files in the background does not slow down
+ *        other work (once per thread).
+ */
+static void lowerThreadPriority()
+{
+    static thread_local auto lowered = false;
+    if (lowered) {
+        return;
+    }
+    lowered = true;
+    // uses SCHED_IDLE under Linux (unlike LowestPriority which has no effect under SCHED_OTHER)
+    QThread::currentThread()->setPriority(QThread::IdlePriority);
+#if defined(PLATFORM_LINUX) && defined(SYS_ioprio_set)
+    // use the "idle" I/O scheduling class for the calling thread, see ioprio_set(2)
+    static constexpr int ioPrioWhoProcess = 1, ioPrioClassIdle = 3, ioPrioClassShift = 13;
+    syscall(SYS_ioprio_set, ioPrioWhoProcess, 0, ioPrioClassIdle << ioPrioClassShift);
+#endif
+}
+
+/*!
+ * \class QtGui::TagStatusFileSystemModel
+ * \brief The TagStatusFileSystemModel class is a QFileSystemModel which additionally shows the tag status of files.
+ *
+ * Files of directories loaded by the model are parsed using a thread pool with idle CPU and I/O priority. Only the container format
+ * and the tags are parsed. The results are cached and shown in additional columns (has tag, title, has cover and
+ * issues) so files which need work can be found without opening each one. Loaded directories are watched using the
+ * shared FileWatcher (until their rows are removed) so the cached tag status of files modified by another application
+ * (or the tag editor) is discarded and determined again.
+ */
+
+/*!
+ * \brief Constructs a new model.
+ */
+TagStatusFileSystemModel::TagStatusFileSystemModel(QObject *parent)
+    : QFileSystemModel(parent)
+    , m_aborted(false)
+    , m_tagStatusShown(true)
+{
+    qRegisterMetaType<TagStatus>();
+    m_threadPool.setMaxThreadCount(max(1, QThread::idealThreadCount() / 2));
+    connect(this, &QFileSystemModel::directoryLoaded, this, &TagStatusFileSystemModel::scanDirectory);
+    connect(this, &QAbstractItemModel::dataChanged, this, &TagStatusFileSystemModel::scanModifiedFiles);
+    connect(this, &QAbstractItemModel::rowsAboutToBeRemoved, this, &TagStatusFileSystemModel::releaseDirectories);
+    connect(this, &TagStatusFileSystemModel::tagStatusDetermined, this, &TagStatusFileSystemModel::storeTagStatus, Qt::QueuedConnection);
+    auto &fileWatcher = FileWatcher::instance();
+    connect(&fileWatcher, &FileWatcher::fileChanged, this, &TagStatusFileSystemModel::invalidateTagStatus);
+    connect(&fileWatcher, &FileWatcher::fileRemoved, this, &TagStatusFileSystemModel::invalidateTagStatus);
+    connect(&fileWatcher, &FileWatcher::directoryChanged, this, &TagStatusFileSystemModel::scanDirectory);
+}
+
+/*!
+ * \brief Destroys the model waiting for files which are currently parsed.
+ */
+TagStatusFileSystemModel::~TagStatusFileSystemModel()
+{
+    m_aborted = true;
+    m_threadPool.clear();
+    m_threadPool.waitForDone();
+    auto &fileWatcher = FileWatcher::instance();
+    for (const auto &directory : m_loadedDirectories) {
+        fileWatcher.unwatchDirectory(directory);
+    }
+}
+
+/*!
+ * \brief Sets whether the tag status of files is determined and shown.
+ * \remarks When enabled, directories which have already been loaded are scanned.
+ */
+void TagStatusFileSystemModel::setTagStatusShown(bool tagStatusShown)
+{
+    if (m_tagStatusShown == tagStatusShown) {
+        return;
+    }
+    m_tagStatusShown = tagStatusShown;
+    if (!m_tagStatusShown) {
+        m_threadPool.clear();
+        m_pendingFiles.clear();
+        m_invalidatedPendingFiles.clear();
+        return;
+    }
+    for (const auto &directory : m_loadedDirectories) {
+        scanDirectory(directory);
+    }
+}
+
+/*!
+ * \brief Returns the tag status of the file at the specified \a index.
+ * \returns Returns nullptr if the tag status has not been determined yet or is outdated.
+ */
+const TagStatus *TagStatusFileSystemModel::tagStatus(const QModelIndex &index) const
+{
+    if (!m_tagStatusShown || !index.isValid()) {
+        return nullptr;
+    }
+    const auto status = m_tagStatus.constFind(filePath(index));
+    if (status == m_tagStatus.cend() || status->lastModified != lastModified(index) || status->size != size(index)) {
+        return nullptr;
+    }
+    return &status.value();
+}
+
+/*!
+ * \brief Returns whether the file at the specified \a index needs work.
+ *
+ * That is the case if the file has no tag, no title or no cover or if critical issues occurred when parsing it.
+ */
+bool TagStatusFileSystemModel::isIncomplete(const QModelIndex &index) const
+{
+    const auto *const status = tagStatus(index);
+    return status && status->supported && (!status->hasTag || status->title.isEmpty() || !status->hasCover || status->issues >= DiagLevel::Critical);
+}
+
+int TagStatusFileSystemModel::columnCount(const QModelIndex &parent) const
+{
+    const auto columnCount = QFileSystemModel::columnCount(parent);
+    return columnCount ? columnCount + tagStatusColumnCount : 0;
+}
+
+QVariant TagStatusFileSystemModel::data(const QModelIndex &index, int role) const
+{
+    if (index.column() < firstTagStatusColumn) {
+        return QFileSystemModel::data(index, role);
+    }
+    const auto *const status = tagStatus(index);
+    if (!status || !status->supported) {
+        return QVariant();
+    }
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case HasTagColumn:
+            return status->hasTag ? tr("yes") : tr("no");
+        case TitleColumn:
+            return status->title;
+        case HasCoverColumn:
+            return status->hasCover ? tr("yes") : tr("no");
+        case IssuesColumn:
+            switch (status->issues) {
+            case DiagLevel::Warning:
+                return tr("warnings");
+            case DiagLevel::Critical:
+            case DiagLevel::Fatal:
+                return tr("errors");
+            default:
+                return QVariant();
+            }
+        default:;
+        }
+        break;
+    case Qt::DecorationRole:
+        if (index.column() == IssuesColumn) {
+            switch (status->issues) {
+            case DiagLevel::Warning:
+                return FileInfoModel::warningIcon();
+            case DiagLevel::Critical:
+            case DiagLevel::Fatal:
+                return FileInfoModel::errorIcon();
+            default:;
+            }
+        }
+        break;
+    default:;
+    }
+    return QVariant();
+}
+
+QVariant TagStatusFileSystemModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || section < firstTagStatusColumn) {
+        return QFileSystemModel::headerData(section, orientation, role);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case HasTagColumn:
+        return tr("Tag");
+    case TitleColumn:
+        return tr("Title");
+    case HasCoverColumn:
+        return tr("Cover");
+    case IssuesColumn:
+        return tr("Issues");
+    default:
+        return QVariant();
+    }
+}
+
+/*!
+ * \brief Sorts the model by the specified \a column.
+ * \remarks Sorting by the tag status is not supported by QFileSystemModel; the name is used instead.
+ */
+void TagStatusFileSystemModel::sort(int column, Qt::SortOrder order)
+{
+    QFileSystemModel::sort(column < firstTagStatusColumn ? column : 0, order);
+}
+
+/*!
+ * \brief Determines the tag status of the files within the specified directory.
+ */
+void TagStatusFileSystemModel::scanDirectory(const QString &path)
+{
+    if (!m_loadedDirectories.contains(path)) {
+        m_loadedDirectories.insert(path);
+        FileWatcher::instance().watchDirectory(path);
+    }
+    if (!m_tagStatusShown) {
+        return;
+    }
+    const auto parent = index(path);
+    for (int row = 0, rows = rowCount(parent); row != rows; ++row) {
+        scanFile(index(row, 0, parent));
+    }
+}
+
+/*!
+ * \brief Determines the tag status of the files within the specified range again if they have been modified.
+ */
+void TagStatusFileSystemModel::scanModifiedFiles(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (!m_tagStatusShown || topLeft.column() >= firstTagStatusColumn) {
+        return;
+    }
+    for (int row = topLeft.row(), lastRow = bottomRight.row(); row <= lastRow; ++row) {
+        scanFile(topLeft.sibling(row, 0));
+    }
+}
+
+/*!
+ * \brief Stores the specified tag \a status determined for the file at the specified \a path.
+ * \remarks If the file has been changed while it was parsed, the \a status is discarded and the file is parsed again.
+ */
+void TagStatusFileSystemModel::storeTagStatus(const QString &path, const TagStatus &status)
+{
+    if (!m_pendingFiles.remove(path)) {
+        return; // scanning has been stopped in the meantime
+    }
+    if (m_invalidatedPendingFiles.remove(path)) {
+        scanFile(index(path));
+        return;
+    }
+    m_tagStatus[path] = status;
+    const auto firstIndex = index(path, firstTagStatusColumn);
+    if (firstIndex.isValid()) {
+        emit dataChanged(firstIndex, firstIndex.sibling(firstIndex.row(), IssuesColumn));
+    }
+}
+
+/*!
+ * \brief Discards the cached tag status of the file at the specified \a path and determines it (again).
+ * \remarks This slot is connected to the fileChanged() and fileRemoved() signals of the FileWatcher.
+ */
+void TagStatusFileSystemModel::invalidateTagStatus(const QString &path)
+{
+    const auto wasCached = m_tagStatus.remove(path);
+    const auto firstIndex = index(path, firstTagStatusColumn);
+    if (!firstIndex.isValid()) {
+        return;
+    }
+    if (wasCached) {
+        emit dataChanged(firstIndex, firstIndex.sibling(firstIndex.row(), IssuesColumn));
+    }
+    if (!m_tagStatusShown) {
+        return;
+    }
+    if (m_pendingFiles.contains(path)) {
+        // the file might have been read before the change -> scan it again when the pending scan has finished
+        m_invalidatedPendingFiles.insert(path);
+        return;
+    }
+    scanFile(firstIndex.sibling(firstIndex.row(), 0));
+}
+
+/*!
+ * \brief Stops watching the loaded directories within the rows from \a first to \a last which are about to be removed.
+ * \remarks Loaded subdirectories of these directories are released as well because their rows are removed along with them.
+ */
+void TagStatusFileSystemModel::releaseDirectories(const QModelIndex &parent, int first, int last)
+{
+    auto &fileWatcher = FileWatcher::instance();
+    for (int row = first; row <= last; ++row) {
+        const auto child = index(row, 0, parent);
+        if (!isDir(child)) {
+            continue;
+        }
+        const auto path = filePath(child);
+        const auto prefix = path.endsWith(QChar('/')) ? path : QString(path + QChar('/'));
+        for (auto directory = m_loadedDirectories.begin(); directory != m_loadedDirectories.end();) {
+            if (*directory == path || directory->startsWith(prefix)) {
+                fileWatcher.unwatchDirectory(*directory);
+                directory = m_loadedDirectories.erase(directory);
+            } else {
+                ++directory;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Determines the tag status of the file at the specified \a index using the thread pool.
+ * \remarks Does nothing if the file is a directory, already pending or the cached tag status is up-to-date.
+ */
+void TagStatusFileSystemModel::scanFile(const QModelIndex &index)
+{
+    if (!index.isValid() || isDir(index) || tagStatus(index)) {
+        return;
+    }
+    const auto path = filePath(index);
+    if (m_pendingFiles.contains(path)) {
+        return;
+    }
+    m_pendingFiles.insert(path);
+    QtConcurrent::run(&m_threadPool, [this, path] {
+        lowerThreadPriority();
+        if (!m_aborted) {
+            emit tagStatusDetermined(path, determineTagStatus(path));
+        }
+    });
+}
+
+/*!
+ * \brief Determines the tag status of the file at the specified \a path.
+ * \remarks Invoked within a thread of the thread pool so it must not access the model.
+ */
+TagStatus TagStatusFileSystemModel::determineTagStatus(const QString &path)
+{
+    TagStatus status;
+    const QFileInfo info(path);
+    status.lastModified = info.lastModified();
+    status.size = info.size();
+    Diagnostics diag;
+    try {
+        const auto nativePath = toNativeFileName(path);
+        MediaFileInfo fileInfo(string(nativePath.data(), static_cast<size_t>(nativePath.size())));
+        fileInfo.open(true);
+        fileInfo.parseContainerFormat(diag);
+        fileInfo.parseTags(diag);
+        fileInfo.parseAttachments(diag);
+        status.supported = fileInfo.areTagsSupported();
+        status.hasTag = fileInfo.hasAnyTag();
+        for (const auto *const tag : fileInfo.tags()) {
+            if (status.title.isEmpty()) {
+                try {
+                    status.title = Utility::tagValueToQString(tag->value(KnownField::Title));
+                } catch (const ConversionException &) {
+                }
+            }
+            if (!status.hasCover) {
+                status.hasCover = !tag->value(KnownField::Cover).isEmpty();
+            }
+        }
+        for (const auto *const attachment : fileInfo.attachments()) {
+            if (!status.hasCover) {
+                status.hasCover = attachment->mimeType().compare(0, 6, "image/") == 0;
+            }
+        }
+    } catch (const TagParser::Failure &) {
+        diag.emplace_back(DiagLevel::Critical, "A parsing failure occured when reading the file.", "determining tag status");
+        status.supported = true;
+    } catch (const std::ios_base::failure &) {
+        diag.emplace_back(DiagLevel::Critical, "An IO failure occured when reading the file.", "determining tag status");
+        status.supported = true;
+    }
+    status.issues = diag.level();
+    return status;
+}
+
+} // namespace QtGui
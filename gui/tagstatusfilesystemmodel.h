@@ -0,0 +1,87 @@
+#ifndef TAGSTATUSFILESYSTEMMODEL_H
+#define TAGSTATUSFILESYSTEMMODEL_H
+
+#include <tagparser/diagnostics.h>
+
+#include <QDateTime>
+#include <QFileSystemModel>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+
+#include <atomic>
+
+namespace QtGui {
+
+/*!
+ * \brief The TagStatus struct holds the tag status of a file determined by the TagStatusFileSystemModel.
+ */
+struct TagStatus {
+    QDateTime lastModified;
+    qint64 size = -1;
+    QString title;
+    TagParser::DiagLevel issues = TagParser::DiagLevel::None;
+    bool supported = false;
+    bool hasTag = false;
+    bool hasCover = false;
+};
+
+class TagStatusFileSystemModel : public QFileSystemModel {
+    Q_OBJECT
+    Q_PROPERTY(bool tagStatusShown READ isTagStatusShown WRITE setTagStatusShown)
+
+public:
+    enum TagStatusColumn { HasTagColumn = 4, TitleColumn, HasCoverColumn, IssuesColumn };
+    static constexpr int firstTagStatusColumn = HasTagColumn;
+    static constexpr int tagStatusColumnCount = IssuesColumn - HasTagColumn + 1;
+
+    explicit TagStatusFileSystemModel(QObject *parent = nullptr);
+    ~TagStatusFileSystemModel() override;
+
+    bool isTagStatusShown() const;
+    void setTagStatusShown(bool tagStatusShown);
+    const TagStatus *tagStatus(const QModelIndex &index) const;
+    bool isIncomplete(const QModelIndex &index) const;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+Q_SIGNALS:
+    /// \brief Emitted from a thread of the internal thread pool when the tag status of a file has been determined.
+    void tagStatusDetermined(const QString &path, const QtGui::TagStatus &status);
+
+private Q_SLOTS:
+    void scanDirectory(const QString &path);
+    void scanModifiedFiles(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void storeTagStatus(const QString &path, const QtGui::TagStatus &status);
+    void invalidateTagStatus(const QString &path);
+    void releaseDirectories(const QModelIndex &parent, int first, int last);
+
+private:
+    void scanFile(const QModelIndex &index);
+    static TagStatus determineTagStatus(const QString &path);
+
+    QThreadPool m_threadPool;
+    QHash<QString, TagStatus> m_tagStatus;
+    QSet<QString> m_pendingFiles;
+    QSet<QString> m_invalidatedPendingFiles;
+    QSet<QString> m_loadedDirectories;
+    std::atomic<bool> m_aborted;
+    bool m_tagStatusShown;
+};
+
+/*!
+ * \brief Returns whether the tag status of files is determined and shown.
+ */
+inline bool TagStatusFileSystemModel::isTagStatusShown() const
+{
+    return m_tagStatusShown;
+}
+
+} // namespace QtGui
+
+Q_DECLARE_METATYPE(QtGui::TagStatus)
+
+#endif // TAGSTATUSFILESYSTEMMODEL_H
@@ -32,6 +32,7 @@
 #endif
 #include <QBuffer>
 #include <QByteArray>
+#include <QElapsedTimer>
 #include <QResource>
 #include <QString>
 #include <QStringBuilder>
@@ -61,6 +62,15 @@ using namespace Utility;
 
 namespace HtmlInfo {
 
+/// \brief The max. number of siblings rendered within one level of the structure tree (e.g. clusters or cue points).
+constexpr std::size_t maxSiblingsPerLevel = 250;
+/// \brief The max. number of elements rendered within the structure tree at all.
+constexpr std::size_t maxElementNodes = 20000;
+/// \brief The max. size of the generated document in byte after which the structure tree is truncated.
+constexpr int maxDocumentSize = 8 * 1024 * 1024;
+/// \brief The max. time in milliseconds spent for rendering the structure tree.
+constexpr qint64 maxStructureTime = 1000;
+
 inline QString qstr(const char *cstr)
 {
     return QString::fromUtf8(cstr);
@@ -308,18 +318,37 @@ template <> void mkElementContent(QXmlStreamWriter &writer, EbmlElement *element
     }
 }
 
+/*!
+ * \brief Writes references to the style sheet and script shared by multiple documents.
+ */
+void mkAssetReferences(QXmlStreamWriter &writer, const QString &assetPrefix)
+{
+    writer.writeEmptyElement(QStringLiteral("link"));
+    writer.writeAttribute(QStringLiteral("rel"), QStringLiteral("stylesheet"));
+    writer.writeAttribute(QStringLiteral("type"), QStringLiteral("text/css"));
+    writer.writeAttribute(QStringLiteral("href"), assetPrefix + QStringLiteral("style.css"));
+    writer.writeStartElement(QStringLiteral("script"));
+    writer.writeAttribute(QStringLiteral("type"), QStringLiteral("text/javascript"));
+    writer.writeAttribute(QStringLiteral("src"), assetPrefix + QStringLiteral("script.js"));
+    writer.writeCharacters(QString()); // avoid self-closing tag
+    writer.writeEndElement();
+}
+
 class Generator {
 public:
-    Generator(const MediaFileInfo &file, Diagnostics &diag, Diagnostics &diagReparsing)
+    Generator(const MediaFileInfo &file, Diagnostics &diag, Diagnostics &diagReparsing, const QString &assetPrefix)
         : m_writer(&m_res)
         , m_rowMaker(m_writer)
         , m_file(file)
         , m_diag(diag)
         , m_diagReparsing(diagReparsing)
+        , m_assetPrefix(assetPrefix)
+        , m_elementNodes(0)
+        , m_structureTruncated(false)
     {
     }
 
-    QString mkStyle()
+    static QString mkStyle()
     {
         QString res;
         res.append(QStringLiteral("html, body {"
@@ -428,7 +457,7 @@ public:
         return res;
     }
 
-    QString mkScript()
+    static QString mkScript()
     {
         QString res;
         res.append(QStringLiteral("function toggleVisibility(link, objid) {"
@@ -774,13 +803,52 @@ public:
         }
     }
 
+    /*!
+     * \brief Returns whether the budget for rendering the structure tree has been exhausted.
+     * \remarks The time is only checked every 64 elements because it is comparatively expensive.
+     */
+    bool isStructureBudgetExhausted()
+    {
+        return m_elementNodes >= maxElementNodes || m_res.size() >= maxDocumentSize
+            || (!(m_elementNodes % 64) && m_structureTimer.hasExpired(maxStructureTime));
+    }
+
+    void mkOmittedNode(const QString &text)
+    {
+        m_writer.writeStartElement(QStringLiteral("li"));
+        m_writer.writeStartElement(QStringLiteral("em"));
+        m_writer.writeCharacters(text);
+        m_writer.writeEndElement();
+        m_writer.writeEndElement();
+    }
+
     template <class ElementType, bool isAdditional = false> void mkElementNode(ElementType *element)
     {
         m_writer.writeStartElement(QStringLiteral("ul"));
         m_writer.writeAttribute(
             QStringLiteral("class"), element && element->parent() ? QStringLiteral("nodecollapsed") : QStringLiteral("nodeexpanded"));
-        while (element) {
+        for (std::size_t siblingIndex = 0; element && !m_structureTruncated; ++siblingIndex) {
+            if (isStructureBudgetExhausted()) {
+                // stop rendering the tree at all; the message is only shown where the tree has been cut
+                m_structureTruncated = true;
+                mkOmittedNode(QCoreApplication::translate("HtmlInfo", "further elements not shown (the structure is too big to be displayed)"));
+                break;
+            }
+            if (siblingIndex == maxSiblingsPerLevel) {
+                // skip the remaining siblings of this level; counting them is cheap compared to rendering them
+                std::size_t omittedSiblings = 0;
+                for (; element && element->isParsed(); element = element->nextSibling()) {
+                    ++omittedSiblings;
+                }
+                mkOmittedNode(
+                    QCoreApplication::translate("HtmlInfo", "%1 further element(s) not shown", nullptr, static_cast<int>(omittedSiblings))
+                        .arg(omittedSiblings));
+                if (!element) {
+                    break;
+                }
+            }
             if (element->isParsed()) {
+                ++m_elementNodes;
                 m_writer.writeStartElement(QStringLiteral("li"));
                 if (element->firstChild()) {
                     m_writer.writeStartElement(QStringLiteral("span"));
@@ -832,12 +900,24 @@ public:
         m_writer.writeEndElement();
     }
 
+    /*!
+     * \brief Renders the element tree of the specified \a container.
+     * \remarks Huge trees (e.g. the clusters and cue points of long Matroska files) are not rendered completely. Only
+     *          maxSiblingsPerLevel elements are shown per level and rendering stops when the budget for the number of
+     *          elements, the document size or the time is exhausted.
+     */
     template <class ContainerType> void mkElementTree(ContainerType *container)
     {
+        m_elementNodes = 0;
+        m_structureTruncated = false;
+        m_structureTimer.start();
         if (container->firstElement()) {
             mkElementNode(container->firstElement());
         }
         for (auto &element : container->additionalElements()) {
+            if (m_structureTruncated) {
+                break;
+            }
             mkElementNode<typename ContainerType::ContainerElementType, true>(element.get());
         }
     }
@@ -891,17 +971,19 @@ public:
         // <title>
         m_writer.writeTextElement(QStringLiteral("title"), QCoreApplication::translate("HtmlInfo", "Info for %1").arg(qstr(m_file.fileName())));
 
-        // <style>
-        m_writer.writeStartElement(QStringLiteral("style"));
-        m_writer.writeAttribute(QStringLiteral("type"), QStringLiteral("text/css"));
-        m_writer.writeCharacters(mkStyle());
-        m_writer.writeEndElement();
-
-        // <script>
-        m_writer.writeStartElement(QStringLiteral("script"));
-        m_writer.writeAttribute(QStringLiteral("type"), QStringLiteral("text/javascript"));
-        m_writer.writeCDATA(mkScript());
-        m_writer.writeEndElement();
+        // <style> <script>
+        if (m_assetPrefix.isEmpty()) {
+            m_writer.writeStartElement(QStringLiteral("style"));
+            m_writer.writeAttribute(QStringLiteral("type"), QStringLiteral("text/css"));
+            m_writer.writeCharacters(mkStyle());
+            m_writer.writeEndElement();
+            m_writer.writeStartElement(QStringLiteral("script"));
+            m_writer.writeAttribute(QStringLiteral("type"), QStringLiteral("text/javascript"));
+            m_writer.writeCDATA(mkScript());
+            m_writer.writeEndElement();
+        } else {
+            mkAssetReferences(m_writer, m_assetPrefix);
+        }
 
         // </head>
         m_writer.writeEndElement();
@@ -1179,6 +1261,10 @@ private:
     const MediaFileInfo &m_file;
     Diagnostics &m_diag;
     Diagnostics &m_diagReparsing;
+    const QString &m_assetPrefix;
+    std::size_t m_elementNodes;
+    QElapsedTimer m_structureTimer;
+    bool m_structureTruncated;
 };
 
 /*!
@@ -1188,17 +1274,103 @@ private:
  *
  * A QGuiApplication instance should be available for setting fonts.
  * A QApplication instance should be available for standard icons.
+ *
+ * If \a assetPrefix is not empty, the style sheet and the script are not embedded. Instead "style.css" and
+ * "script.js" prefixed with \a assetPrefix are referenced. Those can be generated via generateStyleSheet() and
+ * generateScript(). This is useful to generate info for many files at once and only requires accessing the
+ * file (and not the GUI) so it can be done in a worker thread.
  */
-QByteArray generateInfo(const MediaFileInfo &file, Diagnostics &diag, Diagnostics &diagReparsing)
+QByteArray generateInfo(const MediaFileInfo &file, Diagnostics &diag, Diagnostics &diagReparsing, const QString &assetPrefix)
 {
-    Generator gen(file, diag, diagReparsing);
+    Generator gen(file, diag, diagReparsing, assetPrefix);
     gen.mkDoc();
 #ifdef QT_DEBUG
-    QFile test(QStringLiteral("/tmp/test.xhtml"));
-    test.open(QFile::WriteOnly | QFile::Truncate);
-    test.write(gen.res());
+    if (assetPrefix.isEmpty()) {
+        QFile test(QStringLiteral("/tmp/test.xhtml"));
+        test.open(QFile::WriteOnly | QFile::Truncate);
+        test.write(gen.res());
+    }
 #endif
     return gen.res();
 }
 
+/*!
+ * \brief Generates the style sheet referenced by documents generated via generateInfo() with an asset prefix.
+ */
+QByteArray generateStyleSheet()
+{
+    return Generator::mkStyle().toUtf8();
+}
+
+/*!
+ * \brief Generates the script referenced by documents generated via generateInfo() with an asset prefix.
+ */
+QByteArray generateScript()
+{
+    return Generator::mkScript().toUtf8();
+}
+
+/*!
+ * \brief Generates an index for the documents generated for multiple files.
+ *
+ * The \a entries are listed in the specified order. The style sheet and script are referenced using the specified
+ * \a assetPrefix (see generateInfo()).
+ */
+QByteArray generateIndex(const std::vector<IndexEntry> &entries, const QString &assetPrefix)
+{
+    QByteArray res;
+    QXmlStreamWriter writer(&res);
+#ifdef QT_DEBUG
+    writer.setAutoFormatting(true);
+#endif
+    writer.writeStartDocument();
+    writer.writeDTD(
+        QStringLiteral("<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Strict//EN\" \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-strict.dtd\">"));
+    writer.writeStartElement(QStringLiteral("html"));
+    writer.writeAttribute(QStringLiteral("xmlns"), QStringLiteral("http://www.w3.org/1999/xhtml"));
+    writer.writeStartElement(QStringLiteral("head"));
+    writer.writeTextElement(QStringLiteral("title"),
+        QCoreApplication::translate("HtmlInfo", "Info for %1 file(s)", nullptr, static_cast<int>(entries.size())).arg(entries.size()));
+    mkAssetReferences(writer, assetPrefix);
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("body"));
+    writer.writeStartElement(QStringLiteral("table"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("headerhorizontal"));
+    writer.writeStartElement(QStringLiteral("thead"));
+    writer.writeStartElement(QStringLiteral("tr"));
+    for (const auto &label : { QCoreApplication::translate("HtmlInfo", "Path"), QCoreApplication::translate("HtmlInfo", "Container"),
+             QCoreApplication::translate("HtmlInfo", "Size"), QCoreApplication::translate("HtmlInfo", "Duration"),
+             QCoreApplication::translate("HtmlInfo", "Notifications") }) {
+        writer.writeTextElement(QStringLiteral("th"), label);
+    }
+    writer.writeEndElement();
+    writer.writeEndElement();
+    writer.writeStartElement(QStringLiteral("tbody"));
+    auto even = true;
+    for (const auto &entry : entries) {
+        writer.writeStartElement(QStringLiteral("tr"));
+        if ((even = !even)) {
+            writer.writeAttribute(QStringLiteral("class"), QStringLiteral("even"));
+        }
+        writer.writeStartElement(QStringLiteral("td"));
+        if (entry.link.isEmpty()) {
+            writer.writeCharacters(entry.path);
+        } else {
+            writer.writeStartElement(QStringLiteral("a"));
+            writer.writeAttribute(QStringLiteral("href"), entry.link);
+            writer.writeCharacters(entry.path);
+            writer.writeEndElement();
+        }
+        writer.writeEndElement();
+        writer.writeTextElement(QStringLiteral("td"), entry.container);
+        writer.writeTextElement(QStringLiteral("td"), entry.size);
+        writer.writeTextElement(QStringLiteral("td"), entry.duration);
+        writer.writeTextElement(QStringLiteral("td"), entry.notifications);
+        writer.writeEndElement();
+    }
+    writer.writeEndDocument();
+    return res;
+}
+
 } // namespace HtmlInfo
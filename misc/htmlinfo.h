@@ -2,8 +2,10 @@
 #define HTMLINFO_H
 
 #include <QByteArray>
+#include <QString>
 
 #include <list>
+#include <vector>
 
 namespace TagParser {
 class MediaFileInfo;
@@ -12,7 +14,23 @@ class Diagnostics;
 
 namespace HtmlInfo {
 
-QByteArray generateInfo(const TagParser::MediaFileInfo &file, TagParser::Diagnostics &diag, TagParser::Diagnostics &diagReparsing);
-}
+/*!
+ * \brief The IndexEntry struct holds the information about a file shown in the index generated via generateIndex().
+ */
+struct IndexEntry {
+    QString path;
+    QString link; /**< the (already URL-encoded) relative URL of the document; no link is shown if empty */
+    QString container;
+    QString size;
+    QString duration;
+    QString notifications;
+};
+
+QByteArray generateInfo(const TagParser::MediaFileInfo &file, TagParser::Diagnostics &diag, TagParser::Diagnostics &diagReparsing,
+    const QString &assetPrefix = QString());
+QByteArray generateStyleSheet();
+QByteArray generateScript();
+QByteArray generateIndex(const std::vector<IndexEntry> &entries, const QString &assetPrefix);
+} // namespace HtmlInfo
 
 #endif // HTMLINFO_H
@@ -3,15 +3,60 @@
 #include "./filteredfilesystemitemmodel.h"
 #include "./tageditorobject.h"
 
+#include <tagparser/exceptions.h>
+#include <tagparser/mediafileinfo.h>
+
+#include <qtutilities/misc/conversion.h>
+
 #include <QDir>
 #include <QStringBuilder>
+#include <QtConcurrent>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <numeric>
+#include <unordered_set>
 
 using namespace std;
+using namespace QtUtilities;
+using namespace TagParser;
 
 namespace RenamingUtility {
 
+#ifndef TAGEDITOR_NO_JSENGINE
+/*!
+ * \brief Script creating the "tageditor" object exposed to renaming scripts.
+ *
+ * The object is a plain JavaScript object rather than the TagEditorObject itself. The information about the current
+ * file is assigned to it as plain properties before the script is executed for a file so reading them within the
+ * script does not involve a meta-call for each access. Functions and writable properties are forwarded to the
+ * TagEditorObject which is passed as argument.
+ */
+static const char *const contextObjectFactory = R"js((function (bridge) {
+    var tageditor = {}
+    var methods = ["parseFileInfo", "parseFileName", "allFiles", "firstFile", "writeLog", "rename", "move", "skip"]
+    methods.forEach(function (method) {
+        tageditor[method] = function () {
+            return bridge[method].apply(bridge, arguments)
+        }
+    })
+    Object.defineProperty(tageditor, "newName", {
+        get: function () { return bridge.newName },
+        set: function (value) { bridge.rename(value) }
+    })
+    Object.defineProperty(tageditor, "newRelativeDirectory", {
+        get: function () { return bridge.newRelativeDirectory },
+        set: function (value) { bridge.move(value) }
+    })
+    Object.defineProperty(tageditor, "note", {
+        get: function () { return bridge.note }
+    })
+    return tageditor
+}))js";
+#endif
+
 RenamingEngine::RenamingEngine(QObject *parent)
     : QObject(parent)
     ,
@@ -31,6 +76,8 @@ RenamingEngine::RenamingEngine(QObject *parent)
 {
 #ifndef TAGEDITOR_NO_JSENGINE
     m_engine.globalObject().setProperty(QStringLiteral("tageditor"), m_tagEditorJsObj);
+    m_contextObj = m_engine.evaluate(QLatin1String(contextObjectFactory) % QStringLiteral("(tageditor)"));
+    m_engine.globalObject().setProperty(QStringLiteral("tageditor"), m_contextObj);
 #endif
     connect(this, &RenamingEngine::previewGenerated, this, &RenamingEngine::processPreviewGenerated);
     connect(this, &RenamingEngine::changingsApplied, this, &RenamingEngine::processChangingsApplied);
@@ -52,6 +99,7 @@ bool RenamingEngine::setProgram(const TAGEDITOR_JS_VALUE &program)
     m_errorMessage.clear();
     m_errorLineNumber = 0;
     m_program = program;
+    m_template = RenamingTemplate();
     return true;
 }
 #endif
@@ -67,6 +115,36 @@ bool RenamingEngine::setProgram(const QString &program)
 #endif
 }
 
+/*!
+ * \brief Sets the template used to generate new file names instead of a script.
+ * \remarks See RenamingTemplate for the syntax. Setting a program via setProgram() disables the template again.
+ * \returns Returns whether the template is valid; if not, errorMessage() describes the problem.
+ */
+bool RenamingEngine::setTemplate(const QString &format)
+{
+    if (!m_template.compile(format.toStdString())) {
+        m_errorMessage = QString::fromStdString(m_template.errorMessage());
+        m_errorLineNumber = 0;
+        return false;
+    }
+    m_errorMessage.clear();
+    m_errorLineNumber = 0;
+    return true;
+}
+
+/*!
+ * \brief Sets the max. number of threads used to parse files in advance when generating the preview via a script.
+ * \remarks When using a template, files are parsed using the global thread pool instead.
+ */
+void RenamingEngine::setMaxThreadCount(int threadCount)
+{
+#ifndef TAGEDITOR_NO_JSENGINE
+    m_tagEditorQObj->setPrefetchThreadCount(threadCount);
+#else
+    Q_UNUSED(threadCount)
+#endif
+}
+
 bool RenamingEngine::generatePreview(const QDir &rootDirectory, bool includeSubdirs)
 {
 #ifndef TAGEDITOR_NO_JSENGINE
@@ -178,10 +256,23 @@ unique_ptr<FileSystemItem> RenamingEngine::generatePreview(const QDir &dir, File
 {
     auto item = make_unique<FileSystemItem>(ItemStatus::Current, ItemType::Dir, dir.dirName(), parent);
     item->setApplied(false);
-    for (const QFileInfo &entry : dir.entryInfoList()) {
+    const auto entries = dir.entryInfoList();
+    const auto templateResults = isTemplateUsed() ? evaluateTemplate(entries) : QVector<TemplateResult>();
+    for (int index = 0, prefetchIndex = 0, count = entries.size(); index != count; ++index) {
+        const QFileInfo &entry = entries.at(index);
         if (entry.fileName() == QLatin1String("..") || entry.fileName() == QLatin1String(".")) {
             continue;
         }
+        // parse the next files in advance if the script parses files so it does not need to wait for reading them
+        if (m_tagEditorQObj->isPrefetchingFileInfos()) {
+            const auto prefetchEnd = min(count, index + 1 + m_tagEditorQObj->prefetchLimit());
+            for (prefetchIndex = max(prefetchIndex, index + 1); prefetchIndex < prefetchEnd; ++prefetchIndex) {
+                const QFileInfo &nextEntry = entries.at(prefetchIndex);
+                if (nextEntry.isFile()) {
+                    m_tagEditorQObj->prefetchFileInfo(nextEntry.absoluteFilePath());
+                }
+            }
+        }
         FileSystemItem *subItem; // will be deleted by parent
         if (entry.isDir() && m_includeSubdirs) {
             subItem = generatePreview(QDir(entry.absoluteFilePath()), item.get()).release();
@@ -192,7 +283,12 @@ unique_ptr<FileSystemItem> RenamingEngine::generatePreview(const QDir &dir, File
             subItem = nullptr;
         }
         if (subItem) {
-            executeScriptForItem(entry, subItem);
+            if (isTemplateUsed()) {
+                executeTemplateForItem(templateResults.at(index), subItem);
+            } else {
+                executeScriptForItem(entry, subItem);
+                m_tagEditorQObj->discardPrefetchedFileInfo(entry.absoluteFilePath());
+            }
             if (subItem->errorOccured()) {
                 ++m_errorsOccured;
             }
@@ -207,77 +303,208 @@ unique_ptr<FileSystemItem> RenamingEngine::generatePreview(const QDir &dir, File
 }
 #endif
 
-void RenamingEngine::applyChangings(FileSystemItem *parentItem)
+/*!
+ * \brief Returns the native absolute path for the specified \a relativePath within \a dir.
+ */
+static string nativeAbsolutePath(const QDir &dir, const QString &relativePath)
+{
+    const auto nativePath = toNativeFileName(dir.absoluteFilePath(relativePath));
+    return string(nativePath.data(), static_cast<size_t>(nativePath.size()));
+}
+
+/*!
+ * \brief Applies the changings of the children of the specified \a rootItem.
+ *
+ * All renames are planned before anything is renamed so conflicts are detected in advance (see RenamingPlan). Then
+ * files are renamed (in parallel for different directories) followed by directories (deepest first so the paths of
+ * the contained entries remain valid until they have been renamed). Existing entries are never replaced. When
+ * aborted, all renames performed so far are reverted and all created directories are removed. The progress is
+ * reported after each wave of renames.
+ */
+void RenamingEngine::applyChangings(FileSystemItem *rootItem)
+{
+    // plan renames; directories are renamed via separate plans (one per depth)
+    vector<RenamingPlan> plans(1);
+    QVector<PlannedChanging> changings;
+    QVector<FileSystemItem *> createdDirectories;
+    planChangings(rootItem, plans, changings, createdDirectories);
+
+    // prepare plans in reverse order of execution so a plan does not create directories targeted by a later plan
+    unordered_set<string> reservedPaths;
+    for (size_t index = 1, count = plans.size(); index <= count; ++index) {
+        auto &plan = plans[index % count];
+        plan.prepare(reservedPaths);
+        for (const auto &operation : plan.operations()) {
+            reservedPaths.emplace(operation.target);
+        }
+    }
+
+    // execute plans processing the groups of each wave via the global thread pool
+    const auto parallelFor = [](size_t count, const function<void(size_t)> &function) {
+        if (count <= 1) {
+            for (size_t index = 0; index != count; ++index) {
+                function(index);
+            }
+            return;
+        }
+        QVector<size_t> indices(static_cast<int>(count));
+        iota(indices.begin(), indices.end(), 0);
+        QtConcurrent::blockingMap(indices, [&function](size_t index) { function(index); });
+    };
+    const auto isAborted = [this] { return this->isAborted(); };
+    const auto itemCount = m_itemsProcessed;
+    m_itemsProcessed -= changings.size();
+    m_errorsOccured = countErrors(rootItem);
+    emit progress(m_itemsProcessed, m_errorsOccured);
+    const auto waveExecuted = [this](size_t operationsProcessed, size_t operationsFailed) {
+        m_itemsProcessed += static_cast<int>(operationsProcessed);
+        m_errorsOccured += static_cast<int>(operationsFailed);
+        emit progress(m_itemsProcessed, m_errorsOccured);
+    };
+    for (size_t index = 0, count = plans.size(); index != count && !isAborted(); ++index) {
+        plans[index ? count - index : 0].execute(parallelFor, isAborted, waveExecuted);
+    }
+    if (isAborted()) {
+        // revert in reverse order of execution; reverting plans which have not been executed is a no-op except for
+        // removing the created directories recorded in the first plan
+        for (size_t index = 1, count = plans.size(); index <= count; ++index) {
+            plans[index % count].revert();
+        }
+        for (auto *const item : createdDirectories) {
+            if (!m_dir.exists(item->relativePath())) {
+                item->setNote(tr("creation reverted because the operation has been aborted"));
+                item->setApplied(false);
+                item->setErrorOccured(true);
+            }
+        }
+    }
+
+    // update items according to the results
+    for (const auto &changing : changings) {
+        auto *const item = changing.item;
+        const auto &operation = plans[changing.plan].operations()[changing.operation];
+        const auto moved = item->parent() != item->counterpart()->parent();
+        switch (operation.status) {
+        case RenamingStatus::Done:
+            item->setNote(moved ? tr("moved") : tr("renamed"));
+            item->setApplied(true);
+            continue;
+        case RenamingStatus::Pending:
+            item->setNote(tr("not renamed because the operation has been aborted"));
+            break;
+        case RenamingStatus::Reverted:
+            item->setNote(tr("reverted because the operation has been aborted"));
+            break;
+        case RenamingStatus::TargetUsedTwice:
+            item->setNote(tr("generated name is already used"));
+            break;
+        case RenamingStatus::TargetExists:
+            item->setNote(moved ? tr("unable to move, there is already an entry with the same name")
+                                : tr("unable to rename, there is already an entry with the same name"));
+            break;
+        case RenamingStatus::TargetBlocked:
+            item->setNote(tr("unable to rename, the entry with the same name can not be renamed"));
+            break;
+        case RenamingStatus::DirectoryBlocked:
+            item->setNote(tr("unable to move, the target directory is the target of another rename which can not be executed before"));
+            break;
+        case RenamingStatus::Failed:
+            item->setNote(
+                (moved ? tr("unable to move: %1") : tr("unable to rename: %1")).arg(QString::fromLocal8Bit(strerror(operation.errorNumber))));
+            break;
+        }
+        item->setErrorOccured(true);
+    }
+    m_itemsProcessed = itemCount;
+    m_errorsOccured = countErrors(rootItem);
+    emit progress(m_itemsProcessed, m_errorsOccured);
+}
+
+/*!
+ * \brief Adds the renames of the children of the specified \a parentItem to \a plans and creates new directories.
+ * \remarks Renames of files are added to the first plan; renames of directories to the plan for their depth. The
+ *          created directories are recorded in the first plan so they are removed when reverting it; the corresponding
+ *          items are added to \a createdDirectories.
+ */
+void RenamingEngine::planChangings(
+    FileSystemItem *parentItem, vector<RenamingPlan> &plans, QVector<PlannedChanging> &changings, QVector<FileSystemItem *> &createdDirectories)
 {
     for (auto *const item : parentItem->children()) {
-        if (!item->applied() && !item->errorOccured()) {
-            switch (item->status()) {
-            case ItemStatus::New: {
-                const FileSystemItem *counterpartItem = item->counterpart(); // holds current name
-                const QString currentPath = counterpartItem ? counterpartItem->relativePath() : QString();
-                const QString newPath = item->relativePath();
-                if (item->name().isEmpty()) {
-                    // new item name mustn't be empty
-                    item->setNote(tr("generated name is empty"));
-                    item->setErrorOccured(true);
-                } else if (counterpartItem && !counterpartItem->name().isEmpty()) {
-                    // rename current item
-                    if (item->parent() != counterpartItem->parent() || item->name() != counterpartItem->name()) {
-                        if (m_dir.exists(newPath)) {
-                            if (item->parent() == counterpartItem->parent()) {
-                                item->setNote(tr("unable to rename, there is already an entry with the same name"));
-                            } else {
-                                item->setNote(tr("unable to move, there is already an entry with the same name"));
-                            }
-                            item->setErrorOccured(true);
-                        } else if (m_dir.rename(currentPath, newPath)) {
-                            if (item->parent() == counterpartItem->parent()) {
-                                item->setNote(tr("renamed"));
-                            } else {
-                                item->setNote(tr("moved"));
-                            }
-                            item->setApplied(true);
-                        } else {
-                            item->setNote(tr("unable to rename"));
-                            item->setErrorOccured(true);
+        if (item->status() == ItemStatus::New && !item->applied() && !item->errorOccured()) {
+            const FileSystemItem *counterpartItem = item->counterpart(); // holds current name
+            if (item->name().isEmpty()) {
+                // new item name mustn't be empty
+                item->setNote(tr("generated name is empty"));
+                item->setErrorOccured(true);
+            } else if (counterpartItem && !counterpartItem->name().isEmpty()) {
+                // rename current item
+                if (item->parent() != counterpartItem->parent() || item->name() != counterpartItem->name()) {
+                    size_t planIndex = 0;
+                    if (item->type() == ItemType::Dir) {
+                        for (const auto *parent = counterpartItem->parent(); parent; parent = parent->parent()) {
+                            ++planIndex;
+                        }
+                        if (plans.size() <= planIndex) {
+                            plans.resize(planIndex + 1);
                         }
-                    } else {
-                        item->setNote(tr("nothing to be changed"));
-                        item->setApplied(true);
                     }
-                } else if (item->type() == ItemType::Dir) {
-                    // create new item, but only if its a dir
-                    if (m_dir.exists(newPath)) {
-                        item->setNote(tr("directory already existed"));
-                        item->setApplied(true);
-                    } else if (m_dir.mkpath(newPath)) {
-                        item->setNote(tr("directory created"));
-                        item->setApplied(true);
-                    } else {
-                        item->setNote(tr("unable to create directory"));
-                        item->setErrorOccured(true);
+                    const auto operation = plans[planIndex].addOperation(
+                        nativeAbsolutePath(m_dir, counterpartItem->relativePath()), nativeAbsolutePath(m_dir, item->relativePath()));
+                    changings.append(PlannedChanging{ item, planIndex, operation });
+                } else {
+                    item->setNote(tr("nothing to be changed"));
+                    item->setApplied(true);
+                }
+            } else if (item->type() == ItemType::Dir) {
+                // create new item, but only if its a dir
+                const QString newPath = item->relativePath();
+                QStringList missingPaths;
+                for (auto path = newPath; !m_dir.exists(path); path = QFileInfo(path).path()) {
+                    missingPaths << path;
+                }
+                if (missingPaths.isEmpty()) {
+                    item->setNote(tr("directory already existed"));
+                    item->setApplied(true);
+                } else if (m_dir.mkpath(newPath)) {
+                    for (const auto &path : missingPaths) {
+                        plans.front().addCreatedDirectory(nativeAbsolutePath(m_dir, path));
                     }
+                    createdDirectories.append(item);
+                    item->setNote(tr("directory created"));
+                    item->setApplied(true);
                 } else {
-                    // can not create new file
-                    item->setNote(tr("unable to create file"));
+                    item->setNote(tr("unable to create directory"));
                     item->setErrorOccured(true);
                 }
-                break;
-            }
-            case ItemStatus::Current:
-                break;
+            } else {
+                // can not create new file
+                item->setNote(tr("unable to create file"));
+                item->setErrorOccured(true);
             }
         }
+        // plan changings for child items as well
+        if (item->type() == ItemType::Dir) {
+            planChangings(item, plans, changings, createdDirectories);
+        }
+    }
+    m_itemsProcessed += parentItem->children().size();
+}
+
+/*!
+ * \brief Returns the number of items below the specified \a parentItem for which an error occurred.
+ */
+int RenamingEngine::countErrors(const FileSystemItem *parentItem)
+{
+    auto errors = 0;
+    for (const auto *const item : parentItem->children()) {
         if (item->errorOccured()) {
-            ++m_errorsOccured;
+            ++errors;
         }
-        // apply changings for child items as well
         if (item->type() == ItemType::Dir) {
-            applyChangings(item);
+            errors += countErrors(item);
         }
     }
-    m_itemsProcessed += parentItem->children().size();
-    emit progress(m_itemsProcessed, m_errorsOccured);
+    return errors;
 }
 
 void RenamingEngine::setError(const QList<FileSystemItem *> items)
@@ -293,6 +520,11 @@ void RenamingEngine::executeScriptForItem(const QFileInfo &fileInfo, FileSystemI
 {
     // make file info for the specified item available in the script
     m_tagEditorQObj->setFileInfo(fileInfo, item);
+    m_contextObj.setProperty(QStringLiteral("currentPath"), m_tagEditorQObj->currentPath());
+    m_contextObj.setProperty(QStringLiteral("currentName"), m_tagEditorQObj->currentName());
+    m_contextObj.setProperty(QStringLiteral("currentRelativeDirectory"), m_tagEditorQObj->currentRelativeDirectory());
+    m_contextObj.setProperty(QStringLiteral("isDir"), m_tagEditorQObj->isDir());
+    m_contextObj.setProperty(QStringLiteral("isFile"), m_tagEditorQObj->isFile());
 
     // execute script
     const auto scriptResult(m_program.call());
@@ -304,9 +536,83 @@ void RenamingEngine::executeScriptForItem(const QFileInfo &fileInfo, FileSystemI
     }
 
     // create preview for action
-    const QString &newName = m_tagEditorQObj->newName();
-    const QString &newRelativeDirectory = m_tagEditorQObj->newRelativeDirectory();
-    switch (m_tagEditorQObj->action()) {
+    setupAction(item, m_tagEditorQObj->action(), m_tagEditorQObj->newName(), m_tagEditorQObj->newRelativeDirectory(), m_tagEditorQObj->note());
+}
+#endif
+
+/*!
+ * \brief Generates the new paths for the files within the specified \a entries using the template.
+ * \remarks The files are parsed and the template is evaluated in parallel. The results are returned in the order of \a entries;
+ *          the results of directories are left empty. Files of unsupported formats and files without tags are skipped.
+ */
+QVector<RenamingEngine::TemplateResult> RenamingEngine::evaluateTemplate(const QFileInfoList &entries)
+{
+    QVector<TemplateResult> results(entries.size());
+    QVector<int> fileIndices;
+    fileIndices.reserve(entries.size());
+    for (int index = 0, count = entries.size(); index != count; ++index) {
+        if (entries.at(index).isFile()) {
+            fileIndices.append(index);
+        }
+    }
+    auto *const resultData = results.data();
+    QtConcurrent::blockingMap(fileIndices, [this, &entries, resultData](int index) {
+        if (isAborted()) {
+            return;
+        }
+        auto &result = resultData[index];
+        Diagnostics diag;
+        try {
+            const auto nativePath = toNativeFileName(entries.at(index).absoluteFilePath());
+            MediaFileInfo fileInfo(string(nativePath.data(), static_cast<size_t>(nativePath.size())));
+            fileInfo.open(true);
+            fileInfo.parseContainerFormat(diag);
+            if (fileInfo.containerFormat() == ContainerFormat::Unknown) {
+                result.skipReason = tr("format not supported");
+                return;
+            }
+            fileInfo.parseTags(diag);
+            if (!fileInfo.hasAnyTag()) {
+                result.skipReason = tr("file has no tags");
+                return;
+            }
+            result.path = QString::fromStdString(m_template.evaluate(fileInfo));
+        } catch (const Failure &) {
+            result.error = tr("unable to parse the file");
+        } catch (const std::ios_base::failure &) {
+            result.error = tr("unable to read the file");
+        }
+    });
+    return results;
+}
+
+/*!
+ * \brief Creates the preview for the specified \a item from the path generated via the template.
+ * \remarks A path without "/" renames the file within its directory; otherwise the path is relative to the root directory.
+ */
+void RenamingEngine::executeTemplateForItem(const TemplateResult &result, FileSystemItem *item)
+{
+    if (item->type() != ItemType::File || !result.skipReason.isEmpty()) {
+        setupAction(item, ActionType::Skip, QString(), QString(), result.skipReason);
+    } else if (!result.error.isEmpty()) {
+        item->setErrorOccured(true);
+        item->setNote(result.error);
+    } else if (result.path.isEmpty()) {
+        item->setErrorOccured(true);
+        item->setNote(tr("generated name is empty"));
+    } else {
+        const auto separator = result.path.lastIndexOf(QChar('/'));
+        setupAction(item, ActionType::Rename, result.path.mid(separator + 1), separator < 0 ? QString() : result.path.left(separator), QString());
+    }
+}
+
+/*!
+ * \brief Creates the preview for the specified \a item according to the specified \a action.
+ */
+void RenamingEngine::setupAction(
+    FileSystemItem *item, ActionType action, const QString &newName, const QString &newRelativeDirectory, const QString &note)
+{
+    switch (action) {
     case ActionType::None:
         item->setNote(tr("no action specified"));
         break;
@@ -350,10 +656,11 @@ void RenamingEngine::executeScriptForItem(const QFileInfo &fileInfo, FileSystemI
         }
         break;
     default:
-        item->setNote(m_tagEditorQObj->note().isEmpty() ? tr("skipped") : m_tagEditorQObj->note());
+        item->setNote(note.isEmpty() ? tr("skipped") : note);
     }
 }
 
+#ifndef TAGEDITOR_NO_JSENGINE
 PreviewGenerator::PreviewGenerator(RenamingEngine *engine)
     : QThread(engine)
     , m_engine(engine)
@@ -366,7 +673,9 @@ PreviewGenerator::PreviewGenerator(RenamingEngine *engine)
 void PreviewGenerator::run()
 {
     m_engine->resetStatus();
+    m_engine->m_tagEditorQObj->discardPrefetchedFileInfos();
     m_engine->m_newlyGeneratedRootItem = m_engine->generatePreview(m_engine->m_dir);
+    m_engine->m_tagEditorQObj->discardPrefetchedFileInfos();
 }
 
 RenamingThing::RenamingThing(RenamingEngine *engine)
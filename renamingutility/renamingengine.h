@@ -4,16 +4,19 @@
 #include "./filesystemitem.h"
 #include "./jsdefs.h"
 #include "./jsincludes.h"
+#include "./renamingplan.h"
+#include "./renamingtemplate.h"
 
 #include <QAtomicInteger>
 #include <QDir>
+#include <QFileInfo>
 #include <QList>
 #include <QObject>
 #include <QThread>
+#include <QVector>
 
 #include <memory>
-
-QT_FORWARD_DECLARE_CLASS(QFileInfo)
+#include <vector>
 
 namespace RenamingUtility {
 
@@ -61,6 +64,9 @@ public:
     bool setProgram(const TAGEDITOR_JS_VALUE &program);
 #endif
     bool setProgram(const QString &program);
+    bool setTemplate(const QString &format);
+    bool isTemplateUsed() const;
+    void setMaxThreadCount(int threadCount);
     const QDir &rootDirectory() const;
     bool subdirsIncluded() const;
     bool isBusy();
@@ -94,16 +100,35 @@ private:
 #ifndef TAGEDITOR_NO_JSENGINE
     std::unique_ptr<FileSystemItem> generatePreview(const QDir &dir, FileSystemItem *parent = nullptr);
 #endif
-    void applyChangings(FileSystemItem *parentItem);
+    /// \brief The PlannedChanging struct links an item to the operation renaming it within one of the plans used by applyChangings().
+    struct PlannedChanging {
+        FileSystemItem *item;
+        std::size_t plan;
+        std::size_t operation;
+    };
+    void applyChangings(FileSystemItem *rootItem);
+    void planChangings(FileSystemItem *parentItem, std::vector<RenamingPlan> &plans, QVector<PlannedChanging> &changings,
+        QVector<FileSystemItem *> &createdDirectories);
+    static int countErrors(const FileSystemItem *parentItem);
     static void setError(const QList<FileSystemItem *> items);
 #ifndef TAGEDITOR_NO_JSENGINE
     void executeScriptForItem(const QFileInfo &fileInfo, FileSystemItem *item);
 #endif
+    /// \brief The TemplateResult struct holds the path generated via the template for a file or the error which occurred.
+    struct TemplateResult {
+        QString path;
+        QString error;
+        QString skipReason;
+    };
+    QVector<TemplateResult> evaluateTemplate(const QFileInfoList &entries);
+    void executeTemplateForItem(const TemplateResult &result, FileSystemItem *item);
+    void setupAction(FileSystemItem *item, ActionType action, const QString &newName, const QString &newRelativeDirectory, const QString &note);
 
 #ifndef TAGEDITOR_NO_JSENGINE
     TagEditorObject *m_tagEditorQObj;
     TAGEDITOR_JS_ENGINE m_engine;
     TAGEDITOR_JS_VALUE m_tagEditorJsObj;
+    TAGEDITOR_JS_VALUE m_contextObj;
 #endif
     std::unique_ptr<FileSystemItem> m_rootItem;
     std::unique_ptr<FileSystemItem> m_newlyGeneratedRootItem;
@@ -113,6 +138,7 @@ private:
 #ifndef TAGEDITOR_NO_JSENGINE
     TAGEDITOR_JS_VALUE m_program;
 #endif
+    RenamingTemplate m_template;
     QDir m_dir;
     bool m_includeSubdirs;
     bool m_isBusy;
@@ -135,6 +161,14 @@ inline const TAGEDITOR_JS_VALUE &RenamingEngine::scriptProgram() const
 }
 #endif
 
+/*!
+ * \brief Returns whether the template set via setTemplate() is used instead of a script.
+ */
+inline bool RenamingEngine::isTemplateUsed() const
+{
+    return m_template.isValid();
+}
+
 inline const QDir &RenamingEngine::rootDirectory() const
 {
     return m_dir;
@@ -0,0 +1,417 @@
+#include "./renamingplan.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+#ifdef PLATFORM_LINUX
+#include <fcntl.h>
+#endif
+
+using namespace std;
+
+namespace RenamingUtility {
+
+/*!
+ * \class RenamingUtility::RenamingPlan
+ * \brief The RenamingPlan class applies a batch of renames without overwriting any existing files.
+ *
+ * All operations are added before anything is renamed. prepare() builds the map of sources and targets to detect
+ * collisions (targets used twice or occupied by files which are not renamed) in advance and to determine the order
+ * in which the operations need to be executed: An operation whose target is occupied by the source of another
+ * operation is executed after that operation. Cycles (eg. swapping two names) are broken by moving one source to a
+ * temporary name first. Missing target directories are created when executing the operations. If such a directory is
+ * the target of another operation, the operations placing entries within it are executed after that operation.
+ *
+ * execute() performs the operations wave by wave. Within a wave, the operations are grouped by the directory of
+ * their target and the groups are processed in parallel. Each rename is performed atomically without replacing the
+ * target (via renameat2() with RENAME_NOREPLACE under Linux) so a target which has been created in the meantime is
+ * never overwritten. All renames and created directories are recorded so revert() can undo them, eg. when the operation
+ * has been aborted.
+ *
+ * Paths are used as-is so sources and targets must be specified consistently (eg. as absolute and normalized paths).
+ */
+
+namespace {
+
+/// \brief The state of an operation while determining the waves via RenamingPlan::computeWave().
+enum VisitState : unsigned char { Unvisited, Visiting, Visited };
+
+/*!
+ * \brief Returns whether an entry exists at the specified \a path (without following symlinks).
+ */
+bool entryExists(const string &path)
+{
+    std::error_code error;
+    return std::filesystem::exists(std::filesystem::symlink_status(path, error));
+}
+
+/*!
+ * \brief Renames \a from to \a to unless \a to already exists.
+ * \returns Returns whether the entry has been renamed; if not, \a errorNumber is set.
+ */
+bool renameWithoutReplacing(const string &from, const string &to, int &errorNumber)
+{
+#if defined(PLATFORM_LINUX) && defined(RENAME_NOREPLACE)
+    if (!::renameat2(AT_FDCWD, from.c_str(), AT_FDCWD, to.c_str(), RENAME_NOREPLACE)) {
+        return true;
+    }
+    if (errno != EINVAL && errno != ENOSYS) {
+        errorNumber = errno;
+        return false;
+    }
+    // the file system (or kernel) does not support RENAME_NOREPLACE -> check whether the target exists instead
+#endif
+    if (entryExists(to)) {
+        errorNumber = EEXIST;
+        return false;
+    }
+    if (std::rename(from.c_str(), to.c_str())) {
+        errorNumber = errno;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/*!
+ * \brief Adds an operation to rename \a source to \a target.
+ * \returns Returns the index of the operation within operations().
+ * \remarks Must not be called after prepare().
+ */
+size_t RenamingPlan::addOperation(string source, string target)
+{
+    m_operations.emplace_back(move(source), move(target));
+    return m_operations.size() - 1;
+}
+
+/*!
+ * \brief Records that the directory at the specified \a path has been created for the operations of the plan.
+ * \remarks The directory is removed by revert() like the directories created by execute().
+ */
+void RenamingPlan::addCreatedDirectory(string path)
+{
+    m_undoLog.emplace_back(UndoEntry{ numeric_limits<size_t>::max(), string(), move(path) });
+}
+
+/*!
+ * \brief Detects collisions and determines the order the operations are executed in.
+ *
+ * Operations which can not be executed get the corresponding error status; all other operations remain pending.
+ * The \a reservedPaths are the targets of operations executed after this plan (eg. by another plan). Operations whose
+ * target directory would need to be created at one of these paths can not be executed because the later rename
+ * would fail then.
+ *
+ * \returns Returns whether all operations can be executed.
+ */
+bool RenamingPlan::prepare(const unordered_set<string> &reservedPaths)
+{
+    constexpr auto none = numeric_limits<size_t>::max();
+    const auto count = m_operations.size();
+
+    // build map of sources and targets; detect targets used twice
+    unordered_map<string, size_t> sources, targets;
+    sources.reserve(count);
+    targets.reserve(count);
+    for (size_t index = 0; index != count; ++index) {
+        auto &operation = m_operations[index];
+        sources.emplace(operation.source, index);
+        const auto [existing, inserted] = targets.emplace(operation.target, index);
+        if (!inserted) {
+            operation.status = RenamingStatus::TargetUsedTwice;
+            m_operations[existing->second].status = RenamingStatus::TargetUsedTwice;
+        }
+    }
+
+    // determine which operation moves away the entry currently occupying the target; detect existing targets
+    m_vacatedBy.assign(count, none);
+    for (size_t index = 0; index != count; ++index) {
+        auto &operation = m_operations[index];
+        const auto source = sources.find(operation.target);
+        if (source != sources.end() && source->second != index) {
+            m_vacatedBy[index] = source->second;
+        } else if (operation.status == RenamingStatus::Pending && entryExists(operation.target)) {
+            operation.status = RenamingStatus::TargetExists;
+        }
+    }
+
+    // determine which operation creates the missing directory of the target; detect directories which are reserved
+    m_createdBy.assign(count, none);
+    for (size_t index = 0; index != count; ++index) {
+        auto &operation = m_operations[index];
+        if (operation.status != RenamingStatus::Pending) {
+            continue;
+        }
+        for (auto directory = std::filesystem::path(operation.target).parent_path(); !directory.empty() && !entryExists(directory.string());
+             directory = directory.parent_path()) {
+            const auto path = directory.string();
+            if (const auto target = targets.find(path); target != targets.end()) {
+                m_createdBy[index] = target->second;
+                break;
+            }
+            if (reservedPaths.find(path) != reservedPaths.end()) {
+                operation.status = RenamingStatus::DirectoryBlocked;
+                break;
+            }
+        }
+    }
+
+    // determine the wave each operation is executed in; operations depending on failing operations are blocked
+    m_waveOf.assign(count, -1);
+    m_temporaryPaths.assign(count, string());
+    vector<unsigned char> state(count, Unvisited);
+    auto waveCount = 0;
+    for (size_t index = 0; index != count; ++index) {
+        waveCount = max(waveCount, computeWave(index, state) + 1);
+    }
+
+    // group the steps of each wave by the directory of their target
+    m_waves.assign(static_cast<size_t>(waveCount), vector<vector<Step>>());
+    vector<unordered_map<string, size_t>> groupIndices(m_waves.size());
+    const auto addStep = [&](size_t wave, const string &target, Step step) {
+        auto directory = std::filesystem::path(target).parent_path().string();
+        const auto [group, inserted] = groupIndices[wave].emplace(move(directory), m_waves[wave].size());
+        if (inserted) {
+            m_waves[wave].emplace_back();
+        }
+        m_waves[wave][group->second].emplace_back(step);
+    };
+    auto executable = true;
+    for (size_t index = 0; index != count; ++index) {
+        const auto &operation = m_operations[index];
+        if (operation.status != RenamingStatus::Pending) {
+            executable = false;
+            continue;
+        }
+        const auto wave = static_cast<size_t>(m_waveOf[index]);
+        if (m_temporaryPaths[index].empty()) {
+            addStep(wave, operation.target, Step{ index, StepKind::Direct });
+        } else {
+            addStep(0, m_temporaryPaths[index], Step{ index, StepKind::ToTemporary });
+            addStep(wave, operation.target, Step{ index, StepKind::FromTemporary });
+        }
+    }
+    return executable;
+}
+
+/*!
+ * \brief Returns the wave the operation at the specified \a index is executed in or -1 if it can not be executed.
+ * \remarks An operation is executed one wave after the operation which moves away the entry occupying its target and
+ *          one wave after the operation which creates its target directory. Only cycles of the former kind can be
+ *          broken; \a vacating specifies whether the operation is visited as such a dependency.
+ */
+int RenamingPlan::computeWave(size_t index, vector<unsigned char> &state, bool vacating)
+{
+    auto &operation = m_operations[index];
+    if (operation.status != RenamingStatus::Pending) {
+        return -1;
+    }
+    switch (state[index]) {
+    case Visited:
+        return m_waveOf[index];
+    case Visiting: {
+        if (!vacating) {
+            return -1;
+        }
+        // the operation is part of a cycle -> break it by moving the source to a temporary name within the first wave
+        auto temporaryPath = std::filesystem::path(operation.source);
+        temporaryPath.replace_filename('.' + temporaryPath.filename().string() + ".tageditor-renaming");
+        m_temporaryPaths[index] = temporaryPath.string();
+        return 0;
+    }
+    default:;
+    }
+    state[index] = Visiting;
+    auto wave = 0;
+    if (const auto vacatedBy = m_vacatedBy[index]; vacatedBy != numeric_limits<size_t>::max()) {
+        const auto previousWave = computeWave(vacatedBy, state);
+        if (previousWave < 0) {
+            operation.status = RenamingStatus::TargetBlocked;
+        } else {
+            // the source of an operation moved to a temporary name is vacated within the first wave
+            wave = (m_temporaryPaths[vacatedBy].empty() ? previousWave : 0) + 1;
+        }
+    }
+    if (const auto createdBy = m_createdBy[index]; createdBy != numeric_limits<size_t>::max() && operation.status == RenamingStatus::Pending) {
+        const auto previousWave = computeWave(createdBy, state, false);
+        if (previousWave < 0) {
+            operation.status = RenamingStatus::DirectoryBlocked;
+        } else {
+            wave = max(wave, previousWave + 1);
+        }
+    }
+    state[index] = Visited;
+    return m_waveOf[index] = operation.status == RenamingStatus::Pending ? wave : -1;
+}
+
+/*!
+ * \brief Executes the pending operations in the order determined by prepare().
+ *
+ * The groups of each wave are passed to \a parallelFor. When \a isAborted returns true, no further renames are
+ * started. In that case some sources might have been moved to temporary names so revert() should be called.
+ * \a waveExecuted is invoked after each wave (if specified), eg. to report the progress.
+ */
+void RenamingPlan::execute(const ParallelFor &parallelFor, const function<bool()> &isAborted, const WaveCallback &waveExecuted)
+{
+    for (const auto &wave : m_waves) {
+        if (isAborted()) {
+            return;
+        }
+        vector<vector<UndoEntry>> undoLogs(wave.size());
+        parallelFor(wave.size(), [&](size_t group) {
+            for (const auto &step : wave[group]) {
+                if (isAborted()) {
+                    return;
+                }
+                executeStep(step, undoLogs[group]);
+            }
+        });
+        for (auto &undoLog : undoLogs) {
+            move(undoLog.begin(), undoLog.end(), back_inserter(m_undoLog));
+        }
+        if (!waveExecuted) {
+            continue;
+        }
+        size_t processed = 0, failed = 0;
+        for (const auto &group : wave) {
+            for (const auto &step : group) {
+                if (step.kind == StepKind::ToTemporary) {
+                    continue;
+                }
+                const auto status = m_operations[step.operation].status;
+                processed += status != RenamingStatus::Pending;
+                failed += status == RenamingStatus::Failed;
+            }
+        }
+        waveExecuted(processed, failed);
+    }
+}
+
+/*!
+ * \brief Performs the specified \a step recording the rename in \a undoLog.
+ */
+void RenamingPlan::executeStep(const Step &step, vector<UndoEntry> &undoLog)
+{
+    auto &operation = m_operations[step.operation];
+    if (step.kind == StepKind::FromTemporary && operation.status != RenamingStatus::Pending) {
+        return; // moving the source to the temporary name failed
+    }
+    const auto &from = step.kind == StepKind::FromTemporary ? m_temporaryPaths[step.operation] : operation.source;
+    const auto &to = step.kind == StepKind::ToTemporary ? m_temporaryPaths[step.operation] : operation.target;
+    auto renamed = renameWithoutReplacing(from, to, operation.errorNumber);
+    if (!renamed && operation.errorNumber == ENOENT && step.kind != StepKind::ToTemporary) {
+        // create the target directory if it does not exist yet
+        if (createDirectory(std::filesystem::path(to).parent_path().string(), step.operation, undoLog)) {
+            renamed = renameWithoutReplacing(from, to, operation.errorNumber);
+        }
+    }
+    if (renamed) {
+        operation.errorNumber = 0;
+        undoLog.emplace_back(UndoEntry{ step.operation, from, to });
+        if (step.kind != StepKind::ToTemporary) {
+            operation.status = RenamingStatus::Done;
+        }
+        return;
+    }
+    operation.status = RenamingStatus::Failed;
+    if (step.kind == StepKind::FromTemporary) {
+        // move the source back to its original name
+        auto errorNumber = 0;
+        if (renameWithoutReplacing(from, operation.source, errorNumber)) {
+            undoLog.emplace_back(UndoEntry{ step.operation, from, operation.source });
+        }
+    }
+}
+
+/*!
+ * \brief Creates the directory at the specified \a path and its missing parent directories recording them in \a undoLog.
+ * \returns Returns whether the directory exists now.
+ */
+bool RenamingPlan::createDirectory(const string &path, size_t operation, vector<UndoEntry> &undoLog)
+{
+    std::error_code error;
+    if (std::filesystem::create_directory(path, error)) {
+        undoLog.emplace_back(UndoEntry{ operation, string(), path });
+        return true;
+    }
+    if (!error) {
+        return true; // the directory exists (eg. it has just been created for another group)
+    }
+    if (error != std::errc::no_such_file_or_directory) {
+        return false;
+    }
+    const auto parentPath = std::filesystem::path(path).parent_path().string();
+    return !parentPath.empty() && parentPath != path && createDirectory(parentPath, operation, undoLog)
+        && createDirectory(path, operation, undoLog);
+}
+
+/*!
+ * \brief Reverts all renames performed by execute() in reverse order and removes the created directories.
+ * \returns Returns whether all renames could be reverted and all created directories could be removed.
+ */
+bool RenamingPlan::revert()
+{
+    auto reverted = true;
+    vector<const string *> createdDirectories;
+    for (auto entry = m_undoLog.crbegin(); entry != m_undoLog.crend(); ++entry) {
+        if (entry->from.empty()) {
+            createdDirectories.emplace_back(&entry->to);
+            continue;
+        }
+        auto &operation = m_operations[entry->operation];
+        auto errorNumber = 0;
+        if (!renameWithoutReplacing(entry->to, entry->from, errorNumber)) {
+            reverted = false;
+            continue;
+        }
+        if (operation.status == RenamingStatus::Done) {
+            operation.status = RenamingStatus::Reverted;
+        }
+    }
+
+    // remove created directories after all entries have been moved out of them (deepest first)
+    sort(createdDirectories.begin(), createdDirectories.end(), [](const string *lhs, const string *rhs) { return lhs->size() > rhs->size(); });
+    for (const auto *const directory : createdDirectories) {
+        std::error_code error;
+        std::filesystem::remove(*directory, error);
+        if (error) {
+            reverted = false;
+        }
+    }
+    m_undoLog.clear();
+    return reverted;
+}
+
+/*!
+ * \brief Returns a message describing the specified \a status.
+ */
+const char *RenamingPlan::statusMessage(RenamingStatus status)
+{
+    switch (status) {
+    case RenamingStatus::Pending:
+        return "not renamed";
+    case RenamingStatus::Done:
+        return "renamed";
+    case RenamingStatus::Reverted:
+        return "reverted because the operation has been aborted";
+    case RenamingStatus::TargetUsedTwice:
+        return "the target path has been generated for another file as well";
+    case RenamingStatus::TargetExists:
+        return "the target already exists";
+    case RenamingStatus::TargetBlocked:
+        return "the target is occupied by another file which can not be renamed";
+    case RenamingStatus::DirectoryBlocked:
+        return "the target directory does not exist and is the target of another rename which can not be executed before";
+    case RenamingStatus::Failed:
+        return "unable to rename";
+    default:
+        return "unknown status";
+    }
+}
+
+} // namespace RenamingUtility
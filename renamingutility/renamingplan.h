@@ -0,0 +1,105 @@
+#ifndef RENAMINGUTILITY_RENAMINGPLAN_H
+#define RENAMINGUTILITY_RENAMINGPLAN_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace RenamingUtility {
+
+/*!
+ * \brief The RenamingStatus enum specifies the status of an operation within a RenamingPlan.
+ */
+enum class RenamingStatus : unsigned char {
+    Pending, /**< the operation has not been executed (yet) */
+    Done, /**< the operation has been executed */
+    Reverted, /**< the operation has been executed but has been reverted via RenamingPlan::revert() */
+    TargetUsedTwice, /**< another operation has the same target */
+    TargetExists, /**< the target exists and is not moved away by another operation */
+    TargetBlocked, /**< the target is occupied by the source of another operation which can not be executed */
+    DirectoryBlocked, /**< the directory of the target does not exist and is the target of an operation which can not be executed before */
+    Failed, /**< renaming failed; RenamingOperation::errorNumber holds the error */
+};
+
+/*!
+ * \brief The RenamingOperation struct describes a single rename within a RenamingPlan.
+ */
+struct RenamingOperation {
+    RenamingOperation(std::string &&source, std::string &&target);
+
+    std::string source;
+    std::string target;
+    RenamingStatus status;
+    int errorNumber;
+};
+
+inline RenamingOperation::RenamingOperation(std::string &&source, std::string &&target)
+    : source(std::move(source))
+    , target(std::move(target))
+    , status(RenamingStatus::Pending)
+    , errorNumber(0)
+{
+}
+
+class RenamingPlan {
+public:
+    /// \brief Invokes the specified function for each index within [0, count), possibly in parallel.
+    using ParallelFor = std::function<void(std::size_t count, const std::function<void(std::size_t index)> &function)>;
+    /// \brief Is invoked after each wave with the number of operations which have been processed/failed within the wave.
+    using WaveCallback = std::function<void(std::size_t operationsProcessed, std::size_t operationsFailed)>;
+
+    RenamingPlan() = default;
+
+    std::size_t addOperation(std::string source, std::string target);
+    const std::vector<RenamingOperation> &operations() const;
+    void addCreatedDirectory(std::string path);
+    bool prepare(const std::unordered_set<std::string> &reservedPaths = std::unordered_set<std::string>());
+    void execute(const ParallelFor &parallelFor, const std::function<bool()> &isAborted, const WaveCallback &waveExecuted = WaveCallback());
+    bool revert();
+
+    static const char *statusMessage(RenamingStatus status);
+
+private:
+    /// \brief The StepKind enum specifies which part of an operation a Step performs.
+    enum class StepKind : unsigned char { Direct, ToTemporary, FromTemporary };
+    /// \brief The Step struct is a single rename system call performed by execute().
+    struct Step {
+        std::size_t operation;
+        StepKind kind;
+    };
+    /// \brief The UndoEntry struct records a rename performed by execute() so it can be reverted.
+    /// \remarks If \a from is empty, the directory \a to has been created.
+    struct UndoEntry {
+        std::size_t operation;
+        std::string from;
+        std::string to;
+    };
+
+    int computeWave(std::size_t index, std::vector<unsigned char> &state, bool vacating = true);
+    void executeStep(const Step &step, std::vector<UndoEntry> &undoLog);
+    static bool createDirectory(const std::string &path, std::size_t operation, std::vector<UndoEntry> &undoLog);
+
+    std::vector<RenamingOperation> m_operations;
+    std::vector<std::size_t> m_vacatedBy;
+    std::vector<std::size_t> m_createdBy;
+    std::vector<int> m_waveOf;
+    std::vector<std::string> m_temporaryPaths;
+    std::vector<std::vector<std::vector<Step>>> m_waves;
+    std::vector<UndoEntry> m_undoLog;
+};
+
+/*!
+ * \brief Returns the operations added via addOperation().
+ * \remarks The status of the operations is updated by prepare(), execute() and revert().
+ */
+inline const std::vector<RenamingOperation> &RenamingPlan::operations() const
+{
+    return m_operations;
+}
+
+} // namespace RenamingUtility
+
+#endif // RENAMINGUTILITY_RENAMINGPLAN_H
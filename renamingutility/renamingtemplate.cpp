@@ -0,0 +1,308 @@
+#include "./renamingtemplate.h"
+
+#include <tagparser/mediafileinfo.h>
+#include <tagparser/tag.h>
+#include <tagparser/tagvalue.h>
+
+#include <c++utilities/conversion/conversionexception.h>
+#include <c++utilities/conversion/stringbuilder.h>
+
+#include <algorithm>
+#include <string_view>
+
+using namespace std;
+using namespace CppUtilities;
+using namespace TagParser;
+
+namespace RenamingUtility {
+
+/*!
+ * \class RenamingUtility::RenamingTemplate
+ * \brief The RenamingTemplate class generates file names from a format string like "%albumartist%/%album%/%track:02% - %title%".
+ *
+ * The format string is parsed once by compile() into a list of operations which is evaluated for each file by evaluate()
+ * without involving a JavaScript engine. A placeholder consists of one or more field names separated by "|" (the first
+ * non-empty value is used) and an optional width separated by ":" (numbers are padded with zeros to that width). Use "%%"
+ * for a literal "%".
+ *
+ * The generated path is relative and "/" separates directories. The extension of the file is always appended. Characters
+ * which are not suitable for file names are removed from the values and "/" and "\" within values are replaced by " - ".
+ */
+
+namespace {
+
+/// \brief The FieldName struct maps the name used within templates to the TemplateField and the corresponding KnownField.
+struct FieldName {
+    const char *name;
+    TemplateField field;
+    KnownField knownField;
+};
+
+// clang-format off
+const FieldName fieldNameTable[] = {
+    { "title", TemplateField::Title, KnownField::Title },
+    { "artist", TemplateField::Artist, KnownField::Artist },
+    { "albumartist", TemplateField::AlbumArtist, KnownField::AlbumArtist },
+    { "album", TemplateField::Album, KnownField::Album },
+    { "year", TemplateField::Year, KnownField::Year },
+    { "comment", TemplateField::Comment, KnownField::Comment },
+    { "genre", TemplateField::Genre, KnownField::Genre },
+    { "encoder", TemplateField::Encoder, KnownField::Encoder },
+    { "language", TemplateField::Language, KnownField::Language },
+    { "description", TemplateField::Description, KnownField::Description },
+    { "track", TemplateField::TrackPos, KnownField::TrackPosition },
+    { "tracktotal", TemplateField::TrackTotal, KnownField::TrackPosition },
+    { "disk", TemplateField::DiskPos, KnownField::DiskPosition },
+    { "disktotal", TemplateField::DiskTotal, KnownField::DiskPosition },
+    { "name", TemplateField::Name, KnownField::Invalid },
+};
+// clang-format on
+
+/*!
+ * \brief Returns the entry of the fieldNameTable for the specified \a field.
+ */
+const FieldName &fieldNameEntry(TemplateField field)
+{
+    return fieldNameTable[static_cast<size_t>(field)];
+}
+
+/*!
+ * \brief Appends the specified \a value to \a result removing characters which are not suitable for file names.
+ */
+void appendSanitized(string &result, const string &value)
+{
+    for (const char c : value) {
+        switch (c) {
+        case '/':
+        case '\\':
+            result += " - ";
+            break;
+        case '<':
+        case '>':
+        case '?':
+        case '*':
+        case '|':
+        case ':':
+        case '\"':
+            break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20) {
+                result += c;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Appends the specified \a number to \a result padding it with zeros to the specified \a width.
+ * \remarks Nothing is appended if \a number is zero (which means the value is not present).
+ */
+void appendNumber(string &result, int number, size_t width)
+{
+    if (number <= 0) {
+        return;
+    }
+    const auto digits = to_string(number);
+    if (digits.size() < width) {
+        result.append(width - digits.size(), '0');
+    }
+    result += digits;
+}
+
+/*!
+ * \brief Appends the value of the specified \a field from the specified \a tags (or \a fileInfo) to \a result.
+ * \returns Returns whether a non-empty value has been appended.
+ */
+bool appendFieldValue(string &result, MediaFileInfo &fileInfo, const vector<Tag *> &tags, TemplateField field, size_t width)
+{
+    const auto sizeBefore = result.size();
+    switch (field) {
+    case TemplateField::Name:
+        appendSanitized(result, fileInfo.fileName(true));
+        break;
+    case TemplateField::TrackPos:
+    case TemplateField::TrackTotal:
+    case TemplateField::DiskPos:
+    case TemplateField::DiskTotal:
+        for (const auto *const tag : tags) {
+            try {
+                const auto position = tag->value(fieldNameEntry(field).knownField).toPositionInSet();
+                const auto number = (field == TemplateField::TrackPos || field == TemplateField::DiskPos) ? position.position() : position.total();
+                if (number > 0) {
+                    appendNumber(result, number, width);
+                    break;
+                }
+            } catch (const ConversionException &) {
+            }
+        }
+        break;
+    default:
+        for (const auto *const tag : tags) {
+            const auto &value = tag->value(fieldNameEntry(field).knownField);
+            if (value.isEmpty()) {
+                continue;
+            }
+            try {
+                appendSanitized(result, value.toString(TagTextEncoding::Utf8));
+            } catch (const ConversionException &) {
+            }
+            if (result.size() != sizeBefore) {
+                break;
+            }
+        }
+    }
+    return result.size() != sizeBefore;
+}
+
+} // namespace
+
+/*!
+ * \brief Parses the specified \a format.
+ * \returns Returns whether the format is valid; if not, errorMessage() describes the problem.
+ */
+bool RenamingTemplate::compile(const string &format)
+{
+    m_operations.clear();
+    m_errorMessage.clear();
+    for (size_t index = 0, size = format.size(); index < size;) {
+        // add literal
+        const auto placeholderBegin = format.find('%', index);
+        if (placeholderBegin != index) {
+            if (m_operations.empty() || !m_operations.back().fields.empty()) {
+                m_operations.emplace_back();
+            }
+            m_operations.back().literal.append(format, index, placeholderBegin == string::npos ? string::npos : placeholderBegin - index);
+            if (placeholderBegin == string::npos) {
+                break;
+            }
+        }
+        const auto placeholderEnd = format.find('%', placeholderBegin + 1);
+        if (placeholderEnd == string::npos) {
+            m_errorMessage = argsToString("The placeholder at position ", placeholderBegin + 1, " is not terminated.");
+            m_operations.clear();
+            return false;
+        }
+        index = placeholderEnd + 1;
+        // add "%" for "%%"
+        if (placeholderEnd == placeholderBegin + 1) {
+            if (m_operations.empty() || !m_operations.back().fields.empty()) {
+                m_operations.emplace_back();
+            }
+            m_operations.back().literal += '%';
+            continue;
+        }
+        // add placeholder
+        auto spec = format.substr(placeholderBegin + 1, placeholderEnd - placeholderBegin - 1);
+        Operation operation;
+        const auto widthBegin = spec.find(':');
+        if (widthBegin != string::npos) {
+            const auto width = spec.substr(widthBegin + 1);
+            if (width.empty() || width.find_first_not_of("0123456789") != string::npos || width.size() > 3) {
+                m_errorMessage = argsToString("The width \"", width, "\" of the placeholder at position ", placeholderBegin + 1, " is invalid.");
+                m_operations.clear();
+                return false;
+            }
+            operation.width = stoul(width);
+            spec.resize(widthBegin);
+        }
+        for (size_t nameBegin = 0;;) {
+            const auto nameEnd = spec.find('|', nameBegin);
+            const auto name = spec.substr(nameBegin, nameEnd == string::npos ? string::npos : nameEnd - nameBegin);
+            const FieldName *fieldName = nullptr;
+            for (const auto &entry : fieldNameTable) {
+                if (name == entry.name) {
+                    fieldName = &entry;
+                    break;
+                }
+            }
+            if (!fieldName) {
+                m_errorMessage = argsToString("The field \"", name, "\" used at position ", placeholderBegin + 1, " is unknown.");
+                m_operations.clear();
+                return false;
+            }
+            operation.fields.emplace_back(fieldName->field);
+            if (nameEnd == string::npos) {
+                break;
+            }
+            nameBegin = nameEnd + 1;
+        }
+        m_operations.emplace_back(move(operation));
+    }
+    if (m_operations.empty()) {
+        m_errorMessage = "The template is empty.";
+        return false;
+    }
+    if (find_if(m_operations.cbegin(), m_operations.cend(), [](const Operation &operation) { return !operation.fields.empty(); })
+        == m_operations.cend()) {
+        m_errorMessage = "The template contains no placeholders.";
+        m_operations.clear();
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Returns the relative path generated for the specified \a fileInfo.
+ * \remarks
+ * - The tags of \a fileInfo must have been parsed before.
+ * - Empty directory names (caused by empty values) as well as "." and ".." are omitted.
+ * - Returns an empty string if the template has not been compiled or none of its placeholders evaluates to a non-empty value
+ *   (eg. the file has no tags) so the literals alone don't generate a name.
+ */
+string RenamingTemplate::evaluate(MediaFileInfo &fileInfo) const
+{
+    const auto tags = fileInfo.tags();
+    string path;
+    auto hasValue = false;
+    for (const auto &operation : m_operations) {
+        if (operation.fields.empty()) {
+            path += operation.literal;
+            continue;
+        }
+        for (const auto field : operation.fields) {
+            if (appendFieldValue(path, fileInfo, tags, field, operation.width)) {
+                hasValue = true;
+                break;
+            }
+        }
+    }
+    if (!hasValue) {
+        return string();
+    }
+
+    // omit empty directory names, "." and ".." and surrounding whitespaces
+    string result;
+    result.reserve(path.size() + 8);
+    for (size_t begin = 0; begin <= path.size();) {
+        auto end = path.find('/', begin);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        const auto first = path.find_first_not_of(' ', begin);
+        if (first != string::npos && first < end) {
+            const auto last = path.find_last_not_of(' ', end - 1);
+            const auto name = string_view(path).substr(first, last - first + 1);
+            if (name != "." && name != "..") {
+                if (!result.empty()) {
+                    result += '/';
+                }
+                result += name;
+            }
+        }
+        begin = end + 1;
+    }
+    if (!result.empty()) {
+        result += fileInfo.extension();
+    }
+    return result;
+}
+
+/*!
+ * \brief Returns the names of the fields which can be used within templates separated by spaces.
+ */
+const char *RenamingTemplate::fieldNames()
+{
+    return "title artist albumartist album year comment genre encoder language description track tracktotal disk disktotal name";
+}
+
+} // namespace RenamingUtility
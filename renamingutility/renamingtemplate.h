@@ -0,0 +1,76 @@
+#ifndef RENAMINGUTILITY_RENAMINGTEMPLATE_H
+#define RENAMINGUTILITY_RENAMINGTEMPLATE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TagParser {
+class MediaFileInfo;
+}
+
+namespace RenamingUtility {
+
+/*!
+ * \brief The TemplateField enum specifies the values which can be used within a RenamingTemplate.
+ */
+enum class TemplateField : unsigned char {
+    Title,
+    Artist,
+    AlbumArtist,
+    Album,
+    Year,
+    Comment,
+    Genre,
+    Encoder,
+    Language,
+    Description,
+    TrackPos,
+    TrackTotal,
+    DiskPos,
+    DiskTotal,
+    Name,
+};
+
+class RenamingTemplate {
+public:
+    RenamingTemplate() = default;
+
+    bool compile(const std::string &format);
+    bool isValid() const;
+    const std::string &errorMessage() const;
+    std::string evaluate(TagParser::MediaFileInfo &fileInfo) const;
+
+    static const char *fieldNames();
+
+private:
+    /// \brief The Operation struct is either a literal or a placeholder for the first non-empty value of the specified fields.
+    struct Operation {
+        std::string literal;
+        std::vector<TemplateField> fields;
+        std::size_t width = 0;
+    };
+
+    std::vector<Operation> m_operations;
+    std::string m_errorMessage;
+};
+
+/*!
+ * \brief Returns whether a template has been compiled successfully.
+ */
+inline bool RenamingTemplate::isValid() const
+{
+    return !m_operations.empty();
+}
+
+/*!
+ * \brief Returns the error message if compile() failed.
+ */
+inline const std::string &RenamingTemplate::errorMessage() const
+{
+    return m_errorMessage;
+}
+
+} // namespace RenamingUtility
+
+#endif // RENAMINGUTILITY_RENAMINGTEMPLATE_H
@@ -6,6 +6,8 @@
 
 #include "../misc/utility.h"
 
+#include <tagparser/abstractattachment.h>
+#include <tagparser/abstractchapter.h>
 #include <tagparser/abstracttrack.h>
 #include <tagparser/exceptions.h>
 #include <tagparser/mediafileinfo.h>
@@ -17,6 +19,7 @@
 #include <c++utilities/conversion/conversionexception.h>
 
 #include <QDir>
+#include <QtConcurrent>
 
 #include <iostream>
 
@@ -86,8 +89,72 @@ TAGEDITOR_JS_VALUE &operator<<(TAGEDITOR_JS_VALUE &tagObject, const Tag &tag)
     return tagObject;
 }
 
+/*!
+ * \brief Returns the parts specified via the names used within the JavaScript API ("tags", "tracks", "chapters" and
+ *        "attachments").
+ * \remarks Unknown names are ignored. If no names are specified, all parts are included.
+ */
+FileInfoParts FileInfoParts::fromStringList(const QStringList &parts)
+{
+    if (parts.isEmpty()) {
+        return FileInfoParts();
+    }
+    FileInfoParts res;
+    res.tags = parts.contains(QLatin1String("tags"));
+    res.tracks = parts.contains(QLatin1String("tracks"));
+    res.chapters = parts.contains(QLatin1String("chapters"));
+    res.attachments = parts.contains(QLatin1String("attachments"));
+    return res;
+}
+
+/*!
+ * \brief The ParsedFileInfo struct holds a file parsed by TagEditorObject::parseFileInfo() or in advance by
+ *        TagEditorObject::prefetchFileInfo().
+ * \remarks Parsing is done within the constructor so it does not involve the JavaScript engine and can therefore
+ *          happen within any thread.
+ */
+struct ParsedFileInfo {
+    explicit ParsedFileInfo(const QString &fileName, const FileInfoParts &parts);
+
+    MediaFileInfo fileInfo;
+    Diagnostics diag;
+    FileInfoParts parts;
+    bool criticalParsingErrorOccured = false;
+    bool ioErrorOccured = false;
+};
+
+ParsedFileInfo::ParsedFileInfo(const QString &fileName, const FileInfoParts &parts)
+    : fileInfo(toNativeFileName(fileName).data())
+    , parts(parts)
+{
+    try {
+        fileInfo.parseContainerFormat(diag);
+        if (parts.tracks) {
+            fileInfo.parseTracks(diag);
+        }
+        if (parts.tags) {
+            fileInfo.parseTags(diag);
+        }
+        if (parts.chapters) {
+            fileInfo.parseChapters(diag);
+        }
+        if (parts.attachments) {
+            fileInfo.parseAttachments(diag);
+        }
+    } catch (const Failure &) {
+        // parsing notifications will be addded anyways
+        criticalParsingErrorOccured = true;
+    } catch (const std::ios_base::failure &) {
+        criticalParsingErrorOccured = true;
+        ioErrorOccured = true;
+    }
+    // close the file so prefetched files do not keep file descriptors open
+    fileInfo.close();
+}
+
 TagEditorObject::TagEditorObject(TAGEDITOR_JS_ENGINE *engine)
     : m_engine(engine)
+    , m_prefetchingFileInfos(false)
     , m_currentType(ItemType::Dir)
     , m_action(ActionType::None)
 {
@@ -104,6 +171,44 @@ void TagEditorObject::setFileInfo(const QFileInfo &file, FileSystemItem *item)
     m_newRelativeDirectory.clear();
 }
 
+/*!
+ * \brief Starts parsing the file with the specified \a fileName in advance using a thread pool.
+ *
+ * The result is used when the script calls parseFileInfo() for that file so the evaluation of the script does not
+ * need to wait for the file to be read. The parts the script has requested for the current file are parsed.
+ */
+void TagEditorObject::prefetchFileInfo(const QString &fileName)
+{
+    if (m_prefetchedFileInfos.contains(fileName)) {
+        return;
+    }
+    m_prefetchedFileInfos.insert(fileName, QtConcurrent::run(&m_prefetchPool, [fileName, parts = m_prefetchedParts] {
+        return make_shared<ParsedFileInfo>(fileName, parts);
+    }));
+}
+
+/*!
+ * \brief Discards the file with the specified \a fileName parsed in advance.
+ * \remarks Does not wait until parsing the file has finished.
+ */
+void TagEditorObject::discardPrefetchedFileInfo(const QString &fileName)
+{
+    m_prefetchedFileInfos.remove(fileName);
+}
+
+/*!
+ * \brief Discards all files parsed in advance and disables parsing files in advance until the script parses the current
+ *        file again.
+ * \remarks Files which are still parsed are waited for.
+ */
+void TagEditorObject::discardPrefetchedFileInfos()
+{
+    m_prefetchPool.clear();
+    m_prefetchPool.waitForDone();
+    m_prefetchedFileInfos.clear();
+    m_prefetchingFileInfos = false;
+}
+
 const QString &TagEditorObject::currentPath() const
 {
     return m_currentPath;
@@ -139,10 +244,31 @@ const QString &TagEditorObject::newRelativeDirectory() const
     return m_newRelativeDirectory;
 }
 
-TAGEDITOR_JS_VALUE TagEditorObject::parseFileInfo(const QString &fileName)
+/*!
+ * \brief Parses the file with the specified \a fileName and returns an object containing the file information.
+ * \param parts Specifies which parts of the file are parsed, eg. ["tags", "tracks"]. Possible parts are "tags", "tracks",
+ *              "chapters" and "attachments". All parts are parsed if none are specified. Properties depending on parts
+ *              which have not been parsed are not present within the returned object.
+ * \remarks Parsing only the parts a script actually needs avoids reading indexes, chapters and attachments.
+ */
+TAGEDITOR_JS_VALUE TagEditorObject::parseFileInfo(const QString &fileName, const QStringList &parts)
 {
-    Diagnostics diag;
-    MediaFileInfo fileInfo(toNativeFileName(fileName).data());
+    // take the file parsed in advance if possible; otherwise parse the file now
+    const auto requestedParts = FileInfoParts::fromStringList(parts);
+    shared_ptr<ParsedFileInfo> parsedFileInfo;
+    const auto prefetchedFileInfo = m_prefetchedFileInfos.constFind(fileName);
+    if (prefetchedFileInfo != m_prefetchedFileInfos.cend()) {
+        parsedFileInfo = prefetchedFileInfo->result();
+    }
+    if (!parsedFileInfo || !parsedFileInfo->parts.includes(requestedParts)) {
+        parsedFileInfo = make_shared<ParsedFileInfo>(fileName, requestedParts);
+    }
+    if (fileName == m_currentPath) {
+        m_prefetchedParts = requestedParts;
+        m_prefetchingFileInfos = true;
+    }
+    auto &fileInfo = parsedFileInfo->fileInfo;
+    const auto &diag = parsedFileInfo->diag;
 
     // add basic file information
     auto fileInfoObject = m_engine->newObject();
@@ -156,34 +282,44 @@ TAGEDITOR_JS_VALUE TagEditorObject::parseFileInfo(const QString &fileName)
     }
     fileInfoObject.setProperty(QStringLiteral("currentSuffix"), suffix TAGEDITOR_JS_READONLY);
 
-    // parse further file information
-    bool criticalParseingErrorOccured = false, ioErrorOccured = false;
-    try {
-        fileInfo.parseEverything(diag);
-    } catch (const Failure &) {
-        // parsing notifications will be addded anyways
-        criticalParseingErrorOccured = true;
-    } catch (const std::ios_base::failure &) {
-        criticalParseingErrorOccured = true;
-        ioErrorOccured = true;
-    }
-
     // add diag messages
     auto diagObj = m_engine->newArray(static_cast<uint>(diag.size()));
     diagObj << diag;
-    criticalParseingErrorOccured |= diag.level() >= DiagLevel::Critical;
-    fileInfoObject.setProperty(QStringLiteral("hasCriticalMessages"), criticalParseingErrorOccured);
-    fileInfoObject.setProperty(QStringLiteral("ioErrorOccured"), ioErrorOccured);
+    fileInfoObject.setProperty(
+        QStringLiteral("hasCriticalMessages"), parsedFileInfo->criticalParsingErrorOccured || diag.level() >= DiagLevel::Critical);
+    fileInfoObject.setProperty(QStringLiteral("ioErrorOccured"), parsedFileInfo->ioErrorOccured);
     fileInfoObject.setProperty(QStringLiteral("diagMessages"), diagObj);
 
-    // add MIME-type, suitable suffix and technical summary
+    // add MIME-type and suitable suffix
     fileInfoObject.setProperty(QStringLiteral("mimeType"), QString::fromUtf8(fileInfo.mimeType()) TAGEDITOR_JS_READONLY);
     fileInfoObject.setProperty(QStringLiteral("suitableSuffix"), QString::fromUtf8(fileInfo.containerFormatAbbreviation()) TAGEDITOR_JS_READONLY);
-    fileInfoObject.setProperty(QStringLiteral("technicalSummary"), QString::fromUtf8(fileInfo.technicalSummary().data()) TAGEDITOR_JS_READONLY);
-    fileInfoObject.setProperty(QStringLiteral("hasAudioTracks"), fileInfo.hasTracksOfType(MediaType::Audio) TAGEDITOR_JS_READONLY);
-    fileInfoObject.setProperty(QStringLiteral("hasVideoTracks"), fileInfo.hasTracksOfType(MediaType::Video) TAGEDITOR_JS_READONLY);
 
     // add tag information
+    if (parsedFileInfo->parts.tags) {
+        addTagInformation(fileInfoObject, fileInfo);
+    }
+
+    // add technical summary and track information
+    if (parsedFileInfo->parts.tracks) {
+        addTrackInformation(fileInfoObject, fileInfo);
+    }
+
+    // add chapter and attachment information
+    if (parsedFileInfo->parts.chapters) {
+        addChapterInformation(fileInfoObject, fileInfo);
+    }
+    if (parsedFileInfo->parts.attachments) {
+        addAttachmentInformation(fileInfoObject, fileInfo);
+    }
+
+    return fileInfoObject;
+}
+
+/*!
+ * \brief Adds the tag information of the specified \a fileInfo to the specified \a fileInfoObject.
+ */
+void TagEditorObject::addTagInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo)
+{
     const vector<Tag *> tags = fileInfo.tags();
     auto combinedTagObject = m_engine->newObject();
     auto tagsObject = m_engine->newArray(static_cast<uint>(tags.size()));
@@ -197,8 +333,16 @@ TAGEDITOR_JS_VALUE TagEditorObject::parseFileInfo(const QString &fileName)
     }
     fileInfoObject.setProperty(QStringLiteral("tag"), combinedTagObject TAGEDITOR_JS_READONLY);
     fileInfoObject.setProperty(QStringLiteral("tags"), tagsObject TAGEDITOR_JS_READONLY);
+}
 
-    // add track information
+/*!
+ * \brief Adds the technical summary and the track information of the specified \a fileInfo to the specified \a fileInfoObject.
+ */
+void TagEditorObject::addTrackInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo)
+{
+    fileInfoObject.setProperty(QStringLiteral("technicalSummary"), QString::fromUtf8(fileInfo.technicalSummary().data()) TAGEDITOR_JS_READONLY);
+    fileInfoObject.setProperty(QStringLiteral("hasAudioTracks"), fileInfo.hasTracksOfType(MediaType::Audio) TAGEDITOR_JS_READONLY);
+    fileInfoObject.setProperty(QStringLiteral("hasVideoTracks"), fileInfo.hasTracksOfType(MediaType::Video) TAGEDITOR_JS_READONLY);
     const vector<AbstractTrack *> tracks = fileInfo.tracks();
     auto tracksObject = m_engine->newArray(static_cast<uint>(tracks.size()));
     std::uint32_t trackIndex = 0;
@@ -211,8 +355,55 @@ TAGEDITOR_JS_VALUE TagEditorObject::parseFileInfo(const QString &fileName)
         trackObject.setProperty(QStringLiteral("description"), QString::fromUtf8(track.description().data()));
         tracksObject.setProperty(trackIndex, trackObject TAGEDITOR_JS_READONLY);
     }
+    fileInfoObject.setProperty(QStringLiteral("tracks"), tracksObject TAGEDITOR_JS_READONLY);
+}
 
-    return fileInfoObject;
+/*!
+ * \brief Adds the (top-level) chapters of the specified \a fileInfo to the specified \a fileInfoObject.
+ * \remarks The start and end time are specified in seconds and only present if known.
+ */
+void TagEditorObject::addChapterInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo)
+{
+    const vector<AbstractChapter *> chapters = fileInfo.chapters();
+    auto chaptersObject = m_engine->newArray(static_cast<uint>(chapters.size()));
+    std::uint32_t chapterIndex = 0;
+    for (auto chapterIterator = chapters.cbegin(), end = chapters.cend(); chapterIterator != end; ++chapterIterator, ++chapterIndex) {
+        const AbstractChapter &chapter = **chapterIterator;
+        auto chapterObject = m_engine->newObject();
+        chapterObject.setProperty(QStringLiteral("id"), static_cast<double>(chapter.id()));
+        chapterObject.setProperty(
+            QStringLiteral("name"), chapter.names().empty() ? QString() : QString::fromUtf8(chapter.names().front().data()));
+        if (!chapter.startTime().isNegative()) {
+            chapterObject.setProperty(QStringLiteral("startTime"), chapter.startTime().totalSeconds());
+        }
+        if (!chapter.endTime().isNegative()) {
+            chapterObject.setProperty(QStringLiteral("endTime"), chapter.endTime().totalSeconds());
+        }
+        chaptersObject.setProperty(chapterIndex, chapterObject TAGEDITOR_JS_READONLY);
+    }
+    fileInfoObject.setProperty(QStringLiteral("chapters"), chaptersObject TAGEDITOR_JS_READONLY);
+}
+
+/*!
+ * \brief Adds the attachments of the specified \a fileInfo to the specified \a fileInfoObject.
+ */
+void TagEditorObject::addAttachmentInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo)
+{
+    const vector<AbstractAttachment *> attachments = fileInfo.attachments();
+    auto attachmentsObject = m_engine->newArray(static_cast<uint>(attachments.size()));
+    std::uint32_t attachmentIndex = 0;
+    for (auto attachmentIterator = attachments.cbegin(), end = attachments.cend(); attachmentIterator != end;
+         ++attachmentIterator, ++attachmentIndex) {
+        const AbstractAttachment &attachment = **attachmentIterator;
+        auto attachmentObject = m_engine->newObject();
+        attachmentObject.setProperty(QStringLiteral("id"), static_cast<double>(attachment.id()));
+        attachmentObject.setProperty(QStringLiteral("name"), QString::fromUtf8(attachment.name().data()));
+        attachmentObject.setProperty(QStringLiteral("mimeType"), QString::fromUtf8(attachment.mimeType().data()));
+        attachmentObject.setProperty(QStringLiteral("description"), QString::fromUtf8(attachment.description().data()));
+        attachmentObject.setProperty(QStringLiteral("size"), attachment.data() ? static_cast<double>(attachment.data()->size()) : 0.0);
+        attachmentsObject.setProperty(attachmentIndex, attachmentObject TAGEDITOR_JS_READONLY);
+    }
+    fileInfoObject.setProperty(QStringLiteral("attachments"), attachmentsObject TAGEDITOR_JS_READONLY);
 }
 
 TAGEDITOR_JS_VALUE TagEditorObject::parseFileName(const QString &fileName)
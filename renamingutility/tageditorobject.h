@@ -5,15 +5,48 @@
 
 #include "./jsdefs.h"
 
+#include <QFuture>
+#include <QHash>
 #include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <memory>
 
 QT_FORWARD_DECLARE_CLASS(QFileInfo)
 
+namespace TagParser {
+class MediaFileInfo;
+}
+
 namespace RenamingUtility {
 
 class FileSystemItem;
 enum class ItemType;
 enum class ActionType;
+struct ParsedFileInfo;
+
+/*!
+ * \brief The FileInfoParts struct specifies which parts of a file are parsed by TagEditorObject::parseFileInfo().
+ * \remarks The container format is always parsed.
+ */
+struct FileInfoParts {
+    static FileInfoParts fromStringList(const QStringList &parts);
+    bool includes(const FileInfoParts &other) const;
+
+    bool tags = true;
+    bool tracks = true;
+    bool chapters = true;
+    bool attachments = true;
+};
+
+/*!
+ * \brief Returns whether all parts specified by \a other are included.
+ */
+inline bool FileInfoParts::includes(const FileInfoParts &other) const
+{
+    return (tags || !other.tags) && (tracks || !other.tracks) && (chapters || !other.chapters) && (attachments || !other.attachments);
+}
 
 class TagEditorObject : public QObject {
     Q_OBJECT
@@ -31,6 +64,12 @@ public:
 
     ActionType action() const;
     void setFileInfo(const QFileInfo &file, FileSystemItem *item);
+    bool isPrefetchingFileInfos() const;
+    int prefetchLimit() const;
+    void setPrefetchThreadCount(int threadCount);
+    void prefetchFileInfo(const QString &fileName);
+    void discardPrefetchedFileInfo(const QString &fileName);
+    void discardPrefetchedFileInfos();
 
     const QString &currentPath() const;
     const QString &currentName() const;
@@ -42,7 +81,7 @@ public:
     const QString &note() const;
 
 public Q_SLOTS:
-    TAGEDITOR_JS_VALUE parseFileInfo(const QString &fileName);
+    TAGEDITOR_JS_VALUE parseFileInfo(const QString &fileName, const QStringList &parts = QStringList());
     TAGEDITOR_JS_VALUE parseFileName(const QString &fileName);
     TAGEDITOR_JS_VALUE allFiles(const QString &dirName);
     TAGEDITOR_JS_VALUE firstFile(const QString &dirName);
@@ -52,7 +91,16 @@ public Q_SLOTS:
     void skip(const QString &note = QString());
 
 private:
+    void addTagInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo);
+    void addTrackInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo);
+    void addChapterInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo);
+    void addAttachmentInformation(TAGEDITOR_JS_VALUE &fileInfoObject, TagParser::MediaFileInfo &fileInfo);
+
     TAGEDITOR_JS_ENGINE *m_engine;
+    QThreadPool m_prefetchPool;
+    QHash<QString, QFuture<std::shared_ptr<ParsedFileInfo>>> m_prefetchedFileInfos;
+    FileInfoParts m_prefetchedParts;
+    bool m_prefetchingFileInfos;
     QString m_currentPath;
     QString m_currentName;
     QString m_currentRelativeDirectory;
@@ -73,6 +121,32 @@ inline const QString &TagEditorObject::note() const
     return m_note;
 }
 
+/*!
+ * \brief Returns whether files are parsed in advance.
+ * \remarks That is the case as soon as the script has parsed the current file via parseFileInfo() so scripts which
+ *          do not parse files at all do not cause any additional IO.
+ */
+inline bool TagEditorObject::isPrefetchingFileInfos() const
+{
+    return m_prefetchingFileInfos;
+}
+
+/*!
+ * \brief Returns the max. number of files which should be parsed in advance.
+ */
+inline int TagEditorObject::prefetchLimit() const
+{
+    return m_prefetchPool.maxThreadCount() * 2;
+}
+
+/*!
+ * \brief Sets the max. number of threads used to parse files in advance (defaults to the number of CPU threads).
+ */
+inline void TagEditorObject::setPrefetchThreadCount(int threadCount)
+{
+    m_prefetchPool.setMaxThreadCount(threadCount);
+}
+
 } // namespace RenamingUtility
 
 #endif // TAGEDITOR_NO_JSENGINE
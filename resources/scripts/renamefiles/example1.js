@@ -65,8 +65,8 @@ if (!tageditor.isFile) {
     return
 }
 
-// parse file using the built-in parseFileInfo function
-var fileInfo = tageditor.parseFileInfo(tageditor.currentPath)
+// parse file using the built-in parseFileInfo function (only tags and tracks are needed)
+var fileInfo = tageditor.parseFileInfo(tageditor.currentPath, ["tags", "tracks"])
 var tag = fileInfo.tag
 
 // deduce title and track number from the file name using the built-in parseFileName function (as fallback if tags missing)
@@ -87,7 +87,7 @@ if (fileInfo.currentSuffix === "lrc") {
     // keep the lrc suffix later
     keepSuffix = fileInfo.currentSuffix
     // use the file info from the corresponding *.mp3 file
-    fileInfo = tageditor.parseFileInfo(correspondingMp3File)
+    fileInfo = tageditor.parseFileInfo(correspondingMp3File, ["tags", "tracks"])
     if (fileInfo.ioErrorOccured) {
         tageditor.skip("skipped, " + correspondingMp3File + " not present")
         return
@@ -60,6 +60,7 @@ class CliTests : public TestFixture {
     CPPUNIT_TEST(testReadingAndWritingDocumentTitle);
     CPPUNIT_TEST(testFileLayoutOptions);
     CPPUNIT_TEST(testJsonExport);
+    CPPUNIT_TEST(testValidation);
 #endif
     CPPUNIT_TEST_SUITE_END();
 
@@ -85,6 +86,7 @@ public:
     void testReadingAndWritingDocumentTitle();
     void testFileLayoutOptions();
     void testJsonExport();
+    void testValidation();
 #endif
 
 private:
@@ -187,6 +189,16 @@ void CliTests::testBasicReading()
           "Composer          Noel Gallagher"
         }));
     // clang-format on
+
+    // get specific fields as table
+    const char *const args4[] = { "tageditor", "get", "title", "artist", "track", "--format", "tsv", "-f", flacFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args4);
+    CPPUNIT_ASSERT(stderr.empty());
+    CPPUNIT_ASSERT_EQUAL("file\ttitle\tartist\ttrack\n"s + flacFile + "\tSad Song\tOasis\t3/4\n", stdout);
+    const char *const args5[] = { "tageditor", "get", "album", "title", "--format", "csv", "-f", flacFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args5);
+    CPPUNIT_ASSERT(stderr.empty());
+    CPPUNIT_ASSERT_EQUAL("file,album,title\r\n"s + flacFile + ",Don't Go Away (Apple Lossless),Sad Song\r\n", stdout);
 }
 
 void CliTests::testBasicWriting()
@@ -1012,7 +1024,79 @@ void CliTests::testJsonExport()
     const char *const args[] = { "tageditor", "export", "--pretty", "-f", file.data(), nullptr };
     TESTUTILS_ASSERT_EXEC(args);
     CPPUNIT_ASSERT_EQUAL(expectedJson, stdout);
+
+    // export the same structure as CBOR (array and maps of indefinite length)
+    const char *const args4[] = { "tageditor", "export", "--format", "cbor", "-f", file.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args4);
+    CPPUNIT_ASSERT(stdout.size() > 2);
+    CPPUNIT_ASSERT_EQUAL('\x9F', stdout.front());
+    CPPUNIT_ASSERT_EQUAL('\xFF', stdout.back());
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "\x68" "fileName" "\x69" "test3.mkv", "\x64" "kind" "\x64" "text" }));
+    const char *const args5[] = { "tageditor", "export", "--format", "cbor", "--pretty", "-f", file.data(), nullptr };
+    CPPUNIT_ASSERT(execApp(args5, stdout, stderr) != 0);
+    CPPUNIT_ASSERT(testContainsSubstrings(stderr, { "--pretty can not be combined with the format cbor" }));
+
+    // export only changes since previous run
+    const auto snapshotPath(workingCopyPath("export-snapshot", WorkingCopyMode::NoCopy));
+    const auto copiedFile(workingCopyPath("matroska_wave1/test3.mkv"));
+    remove(snapshotPath.data());
+    const char *const args2[] = { "tageditor", "export", "--since", snapshotPath.data(), "-f", copiedFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args2);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "\"changed\":{", copiedFile.data(), "\"fileName\":\"test3.mkv\"", "\"removed\":[]" }));
+    TESTUTILS_ASSERT_EXEC(args2);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "\"changed\":{}", "\"removed\":[]" }));
+    // files which are not specified anymore are only considered removed when they do not exist anymore
+    const auto otherFile(testFilePath("matroska_wave1/test2.mkv"));
+    const char *const args3[] = { "tageditor", "export", "--since", snapshotPath.data(), "-f", otherFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args3);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "\"changed\":{", otherFile.data(), "\"removed\":[]" }));
+    CPPUNIT_ASSERT_EQUAL(0, remove(copiedFile.data()));
+    const char *const args9[]
+        = { "tageditor", "export", "--since", snapshotPath.data(), "-f", otherFile.data(), copiedFile.data(), nullptr };
+    execApp(args9, stdout, stderr);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "\"changed\":{}", "\"removed\":[", copiedFile.data(), "]" }));
+    TESTUTILS_ASSERT_EXEC(args3);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "\"changed\":{}", "\"removed\":[]" }));
+    CPPUNIT_ASSERT_EQUAL(0, remove(snapshotPath.data()));
+
+    // import the exported document again after modifying the file
+    const auto mkvFile(workingCopyPath("matroska_wave1/test3.mkv"));
+    const auto jsonFile(workingCopyPath("matroska_wave1-test3-import.json", WorkingCopyMode::NoCopy));
+    ofstream(jsonFile, ios_base::out | ios_base::trunc | ios_base::binary) << expectedJson;
+    const char *const args5[] = { "tageditor", "set", "title=foo", "-f", mkvFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args5);
+    const char *const args6[] = { "tageditor", "import", "--input-file", jsonFile.data(), "-f", mkvFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args6);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "Importing tag information for \"", mkvFile.data(), " - Changes have been applied." }));
+    const char *const args7[] = { "tageditor", "get", "title", "-f", mkvFile.data(), nullptr };
+    TESTUTILS_ASSERT_EXEC(args7);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "Title", "Elephant Dream - test 3" }));
+    const char *const args8[] = { "tageditor", "import", "--input-file", jsonFile.data(), nullptr };
+    CPPUNIT_ASSERT(execApp(args8, stdout, stderr) != 0);
+    CPPUNIT_ASSERT(testContainsSubstrings(stderr, { "number of specified files does not match" }));
+    remove(mkvFile.data());
+    remove(jsonFile.data());
 #endif // TAGEDITOR_JSON_EXPORT
 }
 
+void CliTests::testValidation()
+{
+    cout << "\nValidation" << endl;
+    string stdout, stderr;
+
+    // list all files (due to --verbose) as TSV
+    const auto mkvFile(testFilePath("matroska_wave1/test2.mkv"));
+    const char *const args1[] = { "tageditor", "validate", "--format", "tsv", "--verbose", "-f", mkvFile.data(), nullptr };
+    CPPUNIT_ASSERT_EQUAL(0, execApp(args1, stdout, stderr));
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "path\tlevel\tcritical\twarnings\tmessage\n", mkvFile.data(), "\t0\t" }));
+    CPPUNIT_ASSERT(testContainsSubstrings(stderr, { "Validated 1 file(s): 0 with critical issues" }));
+
+    // exit with non-zero status if a file can not be read
+    const auto missingFile(workingCopyPath("validation-missing.mkv", WorkingCopyMode::NoCopy));
+    const char *const args2[] = { "tageditor", "validate", "--format", "json", "-f", mkvFile.data(), missingFile.data(), nullptr };
+    CPPUNIT_ASSERT(execApp(args2, stdout, stderr) != 0);
+    CPPUNIT_ASSERT(testContainsSubstrings(stdout, { "[{\"path\":\"", missingFile.data(), "\",\"critical\":1,", "\"context\":\"validating file\"" }));
+    CPPUNIT_ASSERT(testContainsSubstrings(stderr, { "Validated 2 file(s): 1 with critical issues" }));
+}
+
 #endif // PLATFORM_UNIX
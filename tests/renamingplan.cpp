@@ -0,0 +1,254 @@
+#include "../renamingutility/renamingplan.h"
+
+#include <c++utilities/tests/testutils.h>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+using namespace CppUtilities;
+using namespace RenamingUtility;
+using namespace CPPUNIT_NS;
+
+namespace RenamingUtility {
+
+/*!
+ * \brief Prints a RenamingStatus to enable using it in CPPUNIT_ASSERT_EQUAL.
+ */
+inline std::ostream &operator<<(std::ostream &os, RenamingStatus status)
+{
+    return os << RenamingPlan::statusMessage(status);
+}
+
+} // namespace RenamingUtility
+
+/*!
+ * \brief The RenamingPlanTests class tests the RenamingUtility::RenamingPlan class.
+ */
+class RenamingPlanTests : public TestFixture {
+    CPPUNIT_TEST_SUITE(RenamingPlanTests);
+    CPPUNIT_TEST(testSwappingAndChaining);
+    CPPUNIT_TEST(testCollisions);
+    CPPUNIT_TEST(testDirectories);
+    CPPUNIT_TEST(testReverting);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+    void testSwappingAndChaining();
+    void testCollisions();
+    void testDirectories();
+    void testReverting();
+
+private:
+    string path(const char *relativePath) const;
+    void createFile(const char *relativePath) const;
+    string readFile(const char *relativePath) const;
+    void execute(RenamingPlan &plan) const;
+
+    std::filesystem::path m_dir;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RenamingPlanTests);
+
+void RenamingPlanTests::setUp()
+{
+    m_dir = workingCopyPath("renamingplan", WorkingCopyMode::NoCopy);
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+}
+
+void RenamingPlanTests::tearDown()
+{
+    std::filesystem::remove_all(m_dir);
+}
+
+/*!
+ * \brief Returns the absolute path for the specified \a relativePath within the test directory.
+ */
+string RenamingPlanTests::path(const char *relativePath) const
+{
+    return (m_dir / relativePath).string();
+}
+
+/*!
+ * \brief Creates a file at the specified \a relativePath containing its own name so renames can be verified.
+ */
+void RenamingPlanTests::createFile(const char *relativePath) const
+{
+    ofstream(path(relativePath)) << relativePath;
+}
+
+/*!
+ * \brief Returns the contents of the file at the specified \a relativePath or an empty string if it does not exist.
+ */
+string RenamingPlanTests::readFile(const char *relativePath) const
+{
+    ifstream file(path(relativePath));
+    return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+/*!
+ * \brief Executes the specified \a plan sequentially without aborting.
+ */
+void RenamingPlanTests::execute(RenamingPlan &plan) const
+{
+    plan.execute(
+        [](size_t count, const function<void(size_t)> &function) {
+            for (size_t index = 0; index != count; ++index) {
+                function(index);
+            }
+        },
+        [] { return false; });
+}
+
+/*!
+ * \brief Tests swapping names (which requires a temporary name) and chains of renames (which require a certain order).
+ */
+void RenamingPlanTests::testSwappingAndChaining()
+{
+    createFile("a");
+    createFile("b");
+    createFile("c");
+    createFile("d");
+    createFile("e");
+
+    RenamingPlan plan;
+    plan.addOperation(path("a"), path("b"));
+    plan.addOperation(path("b"), path("a"));
+    plan.addOperation(path("c"), path("d"));
+    plan.addOperation(path("d"), path("e"));
+    plan.addOperation(path("e"), path("f"));
+    CPPUNIT_ASSERT(plan.prepare());
+    execute(plan);
+
+    for (const auto &operation : plan.operations()) {
+        CPPUNIT_ASSERT_EQUAL(RenamingStatus::Done, operation.status);
+    }
+    CPPUNIT_ASSERT_EQUAL("b"s, readFile("a"));
+    CPPUNIT_ASSERT_EQUAL("a"s, readFile("b"));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path("c")));
+    CPPUNIT_ASSERT_EQUAL("c"s, readFile("d"));
+    CPPUNIT_ASSERT_EQUAL("d"s, readFile("e"));
+    CPPUNIT_ASSERT_EQUAL("e"s, readFile("f"));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path(".a.tageditor-renaming")));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path(".b.tageditor-renaming")));
+}
+
+/*!
+ * \brief Tests whether collisions are detected by prepare() so nothing is overwritten.
+ */
+void RenamingPlanTests::testCollisions()
+{
+    createFile("a");
+    createFile("b");
+    createFile("c");
+    createFile("d");
+    createFile("e");
+    createFile("f");
+
+    RenamingPlan plan;
+    const auto usedTwice1 = plan.addOperation(path("a"), path("x"));
+    const auto usedTwice2 = plan.addOperation(path("b"), path("x"));
+    const auto exists = plan.addOperation(path("c"), path("d"));
+    const auto blocked = plan.addOperation(path("e"), path("c"));
+    const auto executable = plan.addOperation(path("f"), path("y"));
+    CPPUNIT_ASSERT(!plan.prepare());
+    const auto &operations = plan.operations();
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::TargetUsedTwice, operations[usedTwice1].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::TargetUsedTwice, operations[usedTwice2].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::TargetExists, operations[exists].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::TargetBlocked, operations[blocked].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::Pending, operations[executable].status);
+
+    execute(plan);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::TargetUsedTwice, operations[usedTwice1].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::Done, operations[executable].status);
+    CPPUNIT_ASSERT(!std::filesystem::exists(path("x")));
+    CPPUNIT_ASSERT_EQUAL("a"s, readFile("a"));
+    CPPUNIT_ASSERT_EQUAL("b"s, readFile("b"));
+    CPPUNIT_ASSERT_EQUAL("c"s, readFile("c"));
+    CPPUNIT_ASSERT_EQUAL("d"s, readFile("d"));
+    CPPUNIT_ASSERT_EQUAL("e"s, readFile("e"));
+    CPPUNIT_ASSERT_EQUAL("f"s, readFile("y"));
+}
+
+/*!
+ * \brief Tests whether missing target directories are created and whether conflicts with such directories are detected.
+ */
+void RenamingPlanTests::testDirectories()
+{
+    createFile("a");
+    createFile("b");
+    createFile("c");
+    std::filesystem::create_directory(path("dir"));
+
+    // the operation moving "b" into "renamed" must be executed after renaming "dir" to "renamed"
+    RenamingPlan plan;
+    const auto moved = plan.addOperation(path("a"), path("new/sub/a"));
+    const auto movedIntoRenamed = plan.addOperation(path("b"), path("renamed/b"));
+    const auto renamed = plan.addOperation(path("dir"), path("renamed"));
+    const auto reserved = plan.addOperation(path("c"), path("reserved/c"));
+    CPPUNIT_ASSERT(!plan.prepare({ path("reserved") }));
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::DirectoryBlocked, plan.operations()[reserved].status);
+
+    execute(plan);
+    const auto &operations = plan.operations();
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::Done, operations[moved].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::Done, operations[movedIntoRenamed].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::Done, operations[renamed].status);
+    CPPUNIT_ASSERT_EQUAL("a"s, readFile("new/sub/a"));
+    CPPUNIT_ASSERT_EQUAL("b"s, readFile("renamed/b"));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path("dir")));
+    CPPUNIT_ASSERT_EQUAL("c"s, readFile("c"));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path("reserved")));
+
+    // the directory of the target can not be created if the operation renaming an entry to it can not be executed
+    createFile("d");
+    createFile("e");
+    RenamingPlan blockingPlan;
+    const auto blocking = blockingPlan.addOperation(path("d"), path("z"));
+    blockingPlan.addOperation(path("e"), path("z"));
+    const auto blockedByDirectory = blockingPlan.addOperation(path("renamed/b"), path("z/b"));
+    CPPUNIT_ASSERT(!blockingPlan.prepare());
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::TargetUsedTwice, blockingPlan.operations()[blocking].status);
+    CPPUNIT_ASSERT_EQUAL(RenamingStatus::DirectoryBlocked, blockingPlan.operations()[blockedByDirectory].status);
+}
+
+/*!
+ * \brief Tests whether revert() restores the previous state including removing the created directories.
+ */
+void RenamingPlanTests::testReverting()
+{
+    createFile("a");
+    createFile("b");
+    createFile("c");
+    std::filesystem::create_directory(path("created"));
+
+    RenamingPlan plan;
+    plan.addCreatedDirectory(path("created"));
+    plan.addOperation(path("a"), path("b"));
+    plan.addOperation(path("b"), path("a"));
+    plan.addOperation(path("c"), path("new/sub/c"));
+    CPPUNIT_ASSERT(plan.prepare());
+    execute(plan);
+    CPPUNIT_ASSERT_EQUAL("c"s, readFile("new/sub/c"));
+
+    CPPUNIT_ASSERT(plan.revert());
+    for (const auto &operation : plan.operations()) {
+        CPPUNIT_ASSERT_EQUAL(RenamingStatus::Reverted, operation.status);
+    }
+    CPPUNIT_ASSERT_EQUAL("a"s, readFile("a"));
+    CPPUNIT_ASSERT_EQUAL("b"s, readFile("b"));
+    CPPUNIT_ASSERT_EQUAL("c"s, readFile("c"));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path("new")));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path("created")));
+    CPPUNIT_ASSERT(!std::filesystem::exists(path(".a.tageditor-renaming")));
+    CPPUNIT_ASSERT_EQUAL(3, static_cast<int>(distance(std::filesystem::directory_iterator(m_dir), std::filesystem::directory_iterator())));
+}
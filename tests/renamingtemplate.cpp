@@ -0,0 +1,110 @@
+#include "../renamingutility/renamingtemplate.h"
+
+#include <tagparser/diagnostics.h>
+#include <tagparser/mediafileinfo.h>
+#include <tagparser/positioninset.h>
+#include <tagparser/tag.h>
+
+#include <c++utilities/tests/testutils.h>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace std;
+using namespace CppUtilities;
+using namespace TagParser;
+using namespace RenamingUtility;
+using namespace CPPUNIT_NS;
+
+/*!
+ * \brief The RenamingTemplateTests class tests the RenamingUtility::RenamingTemplate class.
+ */
+class RenamingTemplateTests : public TestFixture {
+    CPPUNIT_TEST_SUITE(RenamingTemplateTests);
+    CPPUNIT_TEST(testCompiling);
+    CPPUNIT_TEST(testEvaluating);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+    void testCompiling();
+    void testEvaluating();
+
+private:
+    MediaFileInfo m_fileInfo;
+    Diagnostics m_diag;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RenamingTemplateTests);
+
+void RenamingTemplateTests::setUp()
+{
+    // use a file without tags; tags are only created in-memory so the file is never modified
+    m_fileInfo.setPath(testFilePath("matroska_wave1/test2.mkv"));
+    m_fileInfo.open(true);
+    m_fileInfo.parseContainerFormat(m_diag);
+    m_fileInfo.parseTags(m_diag);
+    m_fileInfo.removeAllTags();
+}
+
+void RenamingTemplateTests::tearDown()
+{
+    m_fileInfo.close();
+}
+
+/*!
+ * \brief Tests whether invalid templates are rejected by compile().
+ */
+void RenamingTemplateTests::testCompiling()
+{
+    RenamingTemplate renamingTemplate;
+    CPPUNIT_ASSERT(!renamingTemplate.isValid());
+    CPPUNIT_ASSERT(renamingTemplate.compile("%albumartist|artist%/%album%/%track:02% - %title%"));
+    CPPUNIT_ASSERT(renamingTemplate.isValid());
+    CPPUNIT_ASSERT(renamingTemplate.errorMessage().empty());
+
+    CPPUNIT_ASSERT(!renamingTemplate.compile(string()));
+    CPPUNIT_ASSERT_EQUAL("The template is empty."s, renamingTemplate.errorMessage());
+    CPPUNIT_ASSERT(!renamingTemplate.compile("foo %% bar"));
+    CPPUNIT_ASSERT_EQUAL("The template contains no placeholders."s, renamingTemplate.errorMessage());
+    CPPUNIT_ASSERT(!renamingTemplate.isValid());
+    CPPUNIT_ASSERT(!renamingTemplate.compile("%artist% - %title"));
+    CPPUNIT_ASSERT_EQUAL("The placeholder at position 12 is not terminated."s, renamingTemplate.errorMessage());
+    CPPUNIT_ASSERT(!renamingTemplate.compile("%artist|foo%"));
+    CPPUNIT_ASSERT_EQUAL("The field \"foo\" used at position 1 is unknown."s, renamingTemplate.errorMessage());
+    CPPUNIT_ASSERT(!renamingTemplate.compile("%track:x%"));
+    CPPUNIT_ASSERT_EQUAL("The width \"x\" of the placeholder at position 1 is invalid."s, renamingTemplate.errorMessage());
+    CPPUNIT_ASSERT(!renamingTemplate.compile("%track:%"));
+}
+
+/*!
+ * \brief Tests generating paths via evaluate().
+ */
+void RenamingTemplateTests::testEvaluating()
+{
+    RenamingTemplate renamingTemplate;
+    CPPUNIT_ASSERT(renamingTemplate.compile("%albumartist|artist%/%album%/%track:02% - %title%"));
+
+    // no placeholder evaluates to a value -> the literals alone must not generate a name
+    CPPUNIT_ASSERT(m_fileInfo.tags().empty());
+    CPPUNIT_ASSERT_EQUAL(string(), renamingTemplate.evaluate(m_fileInfo));
+    CPPUNIT_ASSERT(m_fileInfo.createAppropriateTags(TagCreationSettings()));
+    auto *const tag = m_fileInfo.tags().at(0);
+    tag->setValue(KnownField::Year, TagValue("2008"));
+    CPPUNIT_ASSERT_EQUAL(string(), renamingTemplate.evaluate(m_fileInfo));
+
+    // the first non-empty alternative is used, empty directory names are omitted, "/" within values is replaced, numbers are padded
+    tag->setValue(KnownField::Artist, TagValue("Artist"));
+    tag->setValue(KnownField::Title, TagValue("Foo/Bar?"));
+    tag->setValue(KnownField::TrackPosition, TagValue(PositionInSet(3, 12)));
+    CPPUNIT_ASSERT_EQUAL("Artist/03 - Foo - Bar.mkv"s, renamingTemplate.evaluate(m_fileInfo));
+    tag->setValue(KnownField::AlbumArtist, TagValue("Album artist"));
+    tag->setValue(KnownField::Album, TagValue("Album"));
+    CPPUNIT_ASSERT_EQUAL("Album artist/Album/03 - Foo - Bar.mkv"s, renamingTemplate.evaluate(m_fileInfo));
+
+    // "%%" is a literal "%"; a width smaller than the number of digits has no effect
+    CPPUNIT_ASSERT(renamingTemplate.compile("100%% %track:1%-%tracktotal% %name%"));
+    CPPUNIT_ASSERT_EQUAL("100% 3-12 test2.mkv"s, renamingTemplate.evaluate(m_fileInfo));
+}